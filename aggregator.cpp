@@ -0,0 +1,410 @@
+/**
+ * @file Aggregator.cpp
+ * @brief Implements the Aggregator class for parallel analytics over a snapshot of the store.
+ */
+
+#include "aggregator.h"
+#include "studentschema.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief The roll number column of one thread's range of records.
+ */
+using RollColumn = Columns<StudentSchema, "roll">;
+
+/**
+ * @class CountTable
+ * @brief An open-addressing hash table counting occurrences of string keys.
+ *
+ * Keys are views into the snapshot and are stored with their hash, so growing the table and
+ * moving entries between tables never rehashes a string. Linear probing over a flat array
+ * keeps lookups for a working set of a few thousand keys inside the cache.
+ */
+class CountTable {
+public:
+    /**
+     * @struct Entry
+     * @brief One key with its hash and count; a count of 0 marks an empty slot.
+     */
+    struct Entry {
+        size_t hash;
+        string_view key;
+        size_t count;
+    };
+
+    CountTable() : slots(64), used(0) {}
+
+    /**
+     * @brief Adds `count` occurrences of a key.
+     * @param hash The hash of `key`.
+     * @param key The key.
+     * @param count The number of occurrences to add.
+     */
+    void add(size_t hash, string_view key, size_t count) {
+        if (2 * (used + 1) > slots.size()) {
+            grow();
+        }
+
+        size_t mask = slots.size() - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            Entry& entry = slots[i];
+            if (entry.count == 0) {
+                entry = {hash, key, count};
+                ++used;
+                return;
+            }
+            if (entry.hash == hash && entry.key == key) {
+                entry.count += count;
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Calls `f` with every occupied entry.
+     * @param f A callable taking `const Entry&`.
+     */
+    template <typename F>
+    void forEach(F&& f) const {
+        for (const Entry& entry : slots) {
+            if (entry.count != 0) {
+                f(entry);
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the number of distinct keys.
+     * @return The key count.
+     */
+    size_t size() const {
+        return used;
+    }
+
+private:
+    vector<Entry> slots; /**< The table; its size is always a power of two. */
+    size_t used; /**< Number of occupied slots. */
+
+    void grow() {
+        vector<Entry> old(slots.size() * 2);
+        old.swap(slots);
+        size_t mask = slots.size() - 1;
+        for (const Entry& entry : old) {
+            if (entry.count == 0) {
+                continue;
+            }
+            size_t i = entry.hash & mask;
+            while (slots[i].count != 0) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = entry;
+        }
+    }
+};
+
+/**
+ * @brief Runs `f(0)` to `f(n - 1)` on `n` threads, the calling thread included.
+ * @param n The number of tasks.
+ * @param f The task, called with its index.
+ */
+template <typename F>
+void parallel(size_t n, F&& f) {
+    vector<thread> workers;
+    for (size_t i = 1; i < n; ++i) {
+        workers.emplace_back([&f, i] { f(i); });
+    }
+    if (n > 0) {
+        f(0);
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Extracts the part of a name to group by.
+ * @param name The student's name.
+ * @param part The part wanted.
+ * @return A view of that part of `name`.
+ */
+string_view namePart(string_view name, Aggregator::NamePart part) {
+    switch (part) {
+        case Aggregator::NamePart::first:
+            return name.substr(0, name.find(' '));
+        case Aggregator::NamePart::last: {
+            size_t space = name.rfind(' ');
+            return space == string_view::npos ? name : name.substr(space + 1);
+        }
+        default:
+            return name;
+    }
+}
+
+/**
+ * @brief Fills in distinct count, duplicates and gaps from a shared bitmap.
+ * @param columns The roll column of each thread.
+ * @param stats The summary; `min` and `max` must already be set.
+ *
+ * All threads mark the rolls of their own column in one `seen` bitmap with atomic bit
+ * sets, flagging a roll in `dup` when its bit was already set. Memory use is therefore a
+ * quarter of a byte per roll number in the range, however many threads run. A final scan
+ * reads off the results.
+ */
+void bitmapRolls(vector<RollColumn>& columns, RollStats& stats) {
+    const long long range = static_cast<long long>(stats.max) - stats.min + 1;
+    const size_t words = static_cast<size_t>((range + 63) / 64);
+    vector<atomic<uint64_t>> seen(words), dup(words);
+
+    parallel(columns.size(), [&](size_t t) {
+        for (int roll : columns[t].column<"roll">()) {
+            uint64_t i = static_cast<uint64_t>(static_cast<long long>(roll) - stats.min);
+            uint64_t bit = uint64_t{1} << (i & 63);
+            if (seen[i >> 6].fetch_or(bit, memory_order_relaxed) & bit) {
+                dup[i >> 6].fetch_or(bit, memory_order_relaxed);
+            }
+        }
+    });
+
+    long long gapStart = -1;
+    for (size_t w = 0; w < words; ++w) {
+        uint64_t s = seen[w].load(memory_order_relaxed);
+        stats.distinct += static_cast<size_t>(popcount(s));
+
+        for (uint64_t d = dup[w].load(memory_order_relaxed); d != 0; d &= d - 1) {
+            stats.duplicates.push_back(static_cast<int>(stats.min + static_cast<long long>(w * 64 + countr_zero(d))));
+        }
+
+        if ((s == ~uint64_t{0} && gapStart < 0) || (s == 0 && gapStart >= 0)) {
+            continue;
+        }
+        for (size_t b = 0; b < 64 && static_cast<long long>(w * 64 + b) < range; ++b) {
+            long long i = static_cast<long long>(w * 64 + b);
+            bool set = (s >> b) & 1;
+            if (!set && gapStart < 0) {
+                gapStart = i;
+            } else if (set && gapStart >= 0) {
+                stats.gaps.push_back({static_cast<int>(stats.min + gapStart), static_cast<int>(stats.min + i - 1)});
+                gapStart = -1;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Fills in distinct count, duplicates and gaps by sorting.
+ * @param columns The roll column of each thread; sorted and consumed.
+ * @param stats The summary to fill in.
+ *
+ * Used when the roll numbers are too spread out for bitmaps. Each thread sorts its own
+ * column, the sorted runs are merged pairwise in parallel, and a final scan reads off the
+ * results.
+ */
+void sortedRolls(vector<RollColumn>& columns, RollStats& stats) {
+    vector<vector<int>> runs(columns.size());
+
+    parallel(columns.size(), [&](size_t t) {
+        runs[t] = move(columns[t].column<"roll">());
+        sort(runs[t].begin(), runs[t].end());
+    });
+
+    while (runs.size() > 1) {
+        vector<vector<int>> merged((runs.size() + 1) / 2);
+        parallel(merged.size(), [&](size_t i) {
+            if (2 * i + 1 == runs.size()) {
+                merged[i] = move(runs[2 * i]);
+                return;
+            }
+            const vector<int>& a = runs[2 * i];
+            const vector<int>& b = runs[2 * i + 1];
+            merged[i].resize(a.size() + b.size());
+            merge(a.begin(), a.end(), b.begin(), b.end(), merged[i].begin());
+        });
+        runs = move(merged);
+    }
+
+    const vector<int>& sorted = runs[0];
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        if (i > 0 && sorted[i] == sorted[i - 1]) {
+            if (stats.duplicates.empty() || stats.duplicates.back() != sorted[i]) {
+                stats.duplicates.push_back(sorted[i]);
+            }
+            continue;
+        }
+        ++stats.distinct;
+        if (i > 0 && static_cast<long long>(sorted[i]) - sorted[i - 1] > 1) {
+            stats.gaps.push_back({sorted[i - 1] + 1, sorted[i] - 1});
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Creates an aggregator over a snapshot.
+ * @param snapshot The records to aggregate.
+ * @param threads The number of threads to use; 0 uses one per hardware thread.
+ *
+ * The pages of the snapshot are divided into at most `threads` contiguous ranges of nearly
+ * equal length. Pages hold at most StudentStore::pageSize records each, so equal page counts
+ * give each thread a similar amount of work.
+ */
+Aggregator::Aggregator(const StudentStore::Snapshot& snapshot, unsigned threads) : view(snapshot) {
+    size_t n = threads != 0 ? threads : max(1u, thread::hardware_concurrency());
+    size_t pages = view.pageCount();
+    n = max<size_t>(1, min(n, pages));
+
+    for (size_t t = 0; t < n; ++t) {
+        ranges.push_back({pages * t / n, pages * (t + 1) / n});
+    }
+}
+
+/**
+ * @brief Computes the count, distinct count, min, max, duplicates and gaps of roll numbers.
+ * @return The summary.
+ *
+ * Each thread projects the roll numbers of its pages into a contiguous column and finds its
+ * minimum and maximum. When the global range is at most `maxBitmapRange` and at most
+ * `maxBitmapSparsity` times the number of students, the remaining statistics come from a
+ * shared bitmap, otherwise from a parallel sort.
+ */
+RollStats Aggregator::rolls() const {
+    vector<RollColumn> columns(ranges.size());
+    vector<int> mins(ranges.size(), INT_MAX);
+    vector<int> maxs(ranges.size(), INT_MIN);
+
+    parallel(ranges.size(), [&](size_t t) {
+        RollColumn& column = columns[t];
+        size_t n = 0;
+        for (size_t p = ranges[t].first; p < ranges[t].second; ++p) {
+            n += view.page(p).size();
+        }
+        column.reserve(n);
+
+        for (size_t p = ranges[t].first; p < ranges[t].second; ++p) {
+            for (const Student& student : view.page(p)) {
+                column.append(student);
+            }
+        }
+
+        int lo = INT_MAX;
+        int hi = INT_MIN;
+        for (int roll : column.column<"roll">()) {
+            lo = min(lo, roll);
+            hi = max(hi, roll);
+        }
+        mins[t] = lo;
+        maxs[t] = hi;
+    });
+
+    RollStats stats{0, 0, 0, 0, {}, {}};
+    for (const RollColumn& column : columns) {
+        stats.count += column.size();
+    }
+    if (stats.count == 0) {
+        return stats;
+    }
+
+    stats.min = *min_element(mins.begin(), mins.end());
+    stats.max = *max_element(maxs.begin(), maxs.end());
+
+    long long range = static_cast<long long>(stats.max) - stats.min + 1;
+    if (range <= maxBitmapRange && range <= maxBitmapSparsity * static_cast<long long>(stats.count)) {
+        bitmapRolls(columns, stats);
+    } else {
+        sortedRolls(columns, stats);
+    }
+    return stats;
+}
+
+/**
+ * @brief Groups students by part of their name.
+ * @param part The part of the name to group by.
+ * @param k The number of most common groups to return.
+ * @return The distinct and repeated key counts and the top `k` groups.
+ *
+ * In the first pass every thread counts the keys of its own pages in a private table, which
+ * collapses common keys such as surnames to a handful of entries, and then routes each entry
+ * to the partition chosen by its hash. In the second pass every thread merges the entries of
+ * one partition. No key appears in two partitions, so the partial results only need to be
+ * added up and their top-k lists combined.
+ */
+KeyStats Aggregator::groupBy(NamePart part, size_t k) const {
+    using Entry = CountTable::Entry;
+    const size_t n = ranges.size();
+    vector<vector<vector<Entry>>> buckets(n, vector<vector<Entry>>(n));
+
+    parallel(n, [&](size_t t) {
+        hash<string_view> hasher;
+        CountTable local;
+        for (size_t p = ranges[t].first; p < ranges[t].second; ++p) {
+            for (const Student& student : view.page(p)) {
+                string_view key = namePart(student.getName(), part);
+                local.add(hasher(key), key, 1);
+            }
+        }
+
+        for (vector<Entry>& bucket : buckets[t]) {
+            bucket.reserve(local.size() / n + 1);
+        }
+        local.forEach([&](const Entry& entry) {
+            buckets[t][entry.hash % n].push_back(entry);
+        });
+    });
+
+    vector<KeyStats> partials(n);
+    vector<vector<pair<string_view, size_t>>> tops(n);
+
+    parallel(n, [&](size_t p) {
+        CountTable counts;
+        for (size_t t = 0; t < n; ++t) {
+            for (const Entry& entry : buckets[t][p]) {
+                counts.add(entry.hash, entry.key, entry.count);
+            }
+        }
+
+        partials[p].distinct = counts.size();
+        partials[p].repeated = 0;
+        tops[p].reserve(counts.size());
+        counts.forEach([&](const Entry& entry) {
+            partials[p].repeated += entry.count > 1 ? 1 : 0;
+            tops[p].push_back({entry.key, entry.count});
+        });
+
+        auto byCount = [](const pair<string_view, size_t>& a, const pair<string_view, size_t>& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        };
+        size_t keep = min(k, tops[p].size());
+        partial_sort(tops[p].begin(), tops[p].begin() + keep, tops[p].end(), byCount);
+        tops[p].resize(keep);
+    });
+
+    KeyStats stats{0, 0, {}};
+    vector<pair<string_view, size_t>> top;
+    for (size_t p = 0; p < n; ++p) {
+        stats.distinct += partials[p].distinct;
+        stats.repeated += partials[p].repeated;
+        top.insert(top.end(), tops[p].begin(), tops[p].end());
+    }
+
+    sort(top.begin(), top.end(), [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    for (size_t i = 0; i < top.size() && i < k; ++i) {
+        stats.top.push_back({string(top[i].first), top[i].second});
+    }
+    return stats;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file Aggregator.h
+ * @brief Defines the Aggregator class for parallel analytics over a snapshot of the store.
+ */
+
+#ifndef AGGREGATOR_H
+#define AGGREGATOR_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "studentstore.h"
+
+/**
+ * @struct RollStats
+ * @brief Summary of the roll numbers in a snapshot.
+ */
+struct RollStats {
+    std::size_t count; /**< Number of students. */
+    std::size_t distinct; /**< Number of distinct roll numbers. */
+    int min; /**< Smallest roll number; 0 when there are no students. */
+    int max; /**< Largest roll number; 0 when there are no students. */
+    std::vector<int> duplicates; /**< Roll numbers held by more than one student, ascending. */
+    std::vector<std::pair<int, int>> gaps; /**< Missing ranges between min and max, inclusive, ascending. */
+};
+
+/**
+ * @struct GroupCount
+ * @brief The number of students sharing one key.
+ */
+struct GroupCount {
+    std::string key; /**< The shared key, e.g. a full name or a surname. */
+    std::size_t count; /**< Number of students with that key. */
+};
+
+/**
+ * @struct KeyStats
+ * @brief Result of grouping students by a key derived from their name.
+ */
+struct KeyStats {
+    std::size_t distinct; /**< Number of distinct keys. */
+    std::size_t repeated; /**< Number of keys shared by more than one student. */
+    std::vector<GroupCount> top; /**< The most common keys, most common first. */
+};
+
+/**
+ * @class Aggregator
+ * @brief Computes counts, distinct values, duplicates, gaps and top-k groups over a snapshot.
+ *
+ * Each query is a single parallel pass. The snapshot's pages are split into contiguous
+ * ranges, one per thread; every thread builds a partial aggregate over its range and the
+ * partials are merged at the end. Roll numbers are first projected into a contiguous column
+ * so the per-thread loops run over plain integer arrays the compiler can vectorize. Name
+ * groupings are counted per thread and then hash-partitioned between threads, so that each
+ * key is merged by exactly one thread and the per-thread results can simply be concatenated.
+ *
+ * The snapshot must outlive the Aggregator; results never refer back to it.
+ */
+class Aggregator {
+public:
+    /**
+     * @brief Which part of the name to group students by.
+     */
+    enum class NamePart {
+        full, /**< The whole name. */
+        first, /**< The first word of the name. */
+        last /**< The last word of the name, i.e. the surname. */
+    };
+
+    /**
+     * @brief Largest roll number range handled with bitmaps instead of sorting.
+     */
+    static constexpr long long maxBitmapRange = 1LL << 27;
+
+    /**
+     * @brief Largest ratio of roll number range to student count handled with bitmaps.
+     *
+     * Keeps the bitmap at most two bytes per student, so a few far-apart roll numbers are
+     * sorted instead of allocating a bitmap for the whole range.
+     */
+    static constexpr long long maxBitmapSparsity = 8;
+
+    /**
+     * @brief Creates an aggregator over a snapshot.
+     * @param snapshot The records to aggregate.
+     * @param threads The number of threads to use; 0 uses one per hardware thread.
+     */
+    explicit Aggregator(const StudentStore::Snapshot& snapshot, unsigned threads = 0);
+
+    /**
+     * @brief Computes the count, distinct count, min, max, duplicates and gaps of roll numbers.
+     * @return The summary.
+     */
+    RollStats rolls() const;
+
+    /**
+     * @brief Groups students by part of their name.
+     * @param part The part of the name to group by.
+     * @param k The number of most common groups to return.
+     * @return The distinct and repeated key counts and the top `k` groups.
+     */
+    KeyStats groupBy(NamePart part, std::size_t k) const;
+
+private:
+    const StudentStore::Snapshot& view; /**< The records being aggregated. */
+    std::vector<std::pair<std::size_t, std::size_t>> ranges; /**< Page range [first, last) per thread. */
+};
+
+#endif // AGGREGATOR_H
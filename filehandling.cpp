@@ -4,11 +4,18 @@
  */
 
 #include "filehandling.h"
+#include "studentschema.h"
 #include <string>
 #include <iostream>
 #include <iomanip>
 #include <fstream>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
 using namespace std;
 
 /**
@@ -41,14 +48,16 @@ FileHandling::~FileHandling() {
  * @brief Appends a student's record to the file.
  * @param student The Student object whose record is to be appended.
  *
- * This method opens the file in append mode and writes the student's name and roll number
- * to the file. If the file cannot be opened, an error message is printed to the console.
+ * This method opens the file in append mode and writes the student's fields to the file,
+ * as formatted by StudentSchema. If the file cannot be opened, an error message is printed
+ * to the console.
  */
 void FileHandling::appendStudent(const Student& student) {
     filestream.open(filename, ios::app);
 
     if (filestream.is_open()) {
-        filestream << student.getName() << " " << student.getRoll() << endl;
+        StudentSchema::format(filestream, student);
+        filestream << endl;
         filestream.close();
     } else {
         cout << "ERROR: unable to open the file" << endl;
@@ -75,3 +84,61 @@ void FileHandling::readfile() {
     }
 }
 
+
+/**
+ * @brief Reads the whole file into a buffer.
+ * @param contents The buffer that receives the file contents.
+ * @return true if the file could be opened and read, false otherwise.
+ *
+ * This method opens the file in binary mode, sizes the buffer from the file length and
+ * reads everything with a single call.
+ */
+bool FileHandling::readContents(string& contents) {
+    fileRstream.open(filename, ios::in | ios::binary);
+
+    if (!fileRstream.is_open()) {
+        return false;
+    }
+
+    fileRstream.seekg(0, ios::end);
+    streamoff length = fileRstream.tellg();
+    fileRstream.seekg(0, ios::beg);
+
+    contents.resize(length > 0 ? static_cast<size_t>(length) : 0);
+    fileRstream.read(contents.data(), static_cast<streamsize>(contents.size()));
+    contents.resize(static_cast<size_t>(fileRstream.gcount()));
+    fileRstream.close();
+
+    return true;
+}
+
+/**
+ * @brief Blocks until the lock for a file is acquired.
+ * @param fname The file to lock.
+ *
+ * If the lock file cannot be created the object holds no lock, and the caller proceeds
+ * unprotected just as it would without locking.
+ */
+FileLock::FileLock(const string& fname) : fd(-1) {
+#if defined(__unix__) || defined(__APPLE__)
+    fd = open((fname + ".lock").c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd >= 0 && flock(fd, LOCK_EX) != 0) {
+        close(fd);
+        fd = -1;
+    }
+#else
+    (void)fname;
+#endif
+}
+
+/**
+ * @brief Releases the lock.
+ */
+FileLock::~FileLock() {
+#if defined(__unix__) || defined(__APPLE__)
+    if (fd >= 0) {
+        flock(fd, LOCK_UN);
+        close(fd);
+    }
+#endif
+}
@@ -54,8 +54,9 @@ public:
      * @brief Appends a student's record to the file.
      * @param student The Student object whose record is to be appended.
      *
-     * This method writes the data from the provided Student object to the file.
-     * The file is opened in append mode to ensure existing data is preserved.
+     * This method writes the data from the provided Student object to the file in the
+     * text form defined by StudentSchema. The file is opened in append mode to ensure
+     * existing data is preserved.
      */
     void appendStudent(const Student& student);
 
@@ -66,6 +67,45 @@ public:
      * The data is typically processed or displayed as needed.
      */
     void readfile();
+
+    /**
+     * @brief Reads the whole file into a buffer.
+     * @param contents The buffer that receives the file contents.
+     * @return true if the file could be opened and read, false otherwise.
+     *
+     * The buffer is sized once from the file length, so the read costs at most one
+     * allocation regardless of how many records the file holds.
+     */
+    bool readContents(string& contents);
+};
+
+/**
+ * @class FileLock
+ * @brief Holds an exclusive advisory lock shared by every process working on a file.
+ *
+ * The lock is taken on a separate `<filename>.lock` file, so the data file itself can still
+ * be replaced by renaming a temporary file over it. Sessions that read, modify and rewrite
+ * the student file hold the lock for the whole sequence, so they cannot overwrite each
+ * other's changes. On platforms without `flock` the lock does nothing.
+ */
+class FileLock {
+private:
+    int fd; /**< Descriptor of the lock file, or -1 if no lock is held. */
+
+public:
+    /**
+     * @brief Blocks until the lock for a file is acquired.
+     * @param fname The file to lock.
+     */
+    explicit FileLock(const string& fname);
+
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+
+    /**
+     * @brief Releases the lock.
+     */
+    ~FileLock();
 };
 
 #endif // FILEHANDLING_H
@@ -6,7 +6,9 @@
 #include "inputvalidation.h"
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <stdexcept>
+#include <cctype>
 
 using namespace std;
 
@@ -20,18 +22,15 @@ checkInput::checkInput() : name(""), roll(-1) {}
 
 /**
  * @brief Validates and formats the student name.
- * @param n A reference to the student name string to be validated.
- * @return A validated student name.
+ * @param name A view of the student name to be validated.
+ * @return A view of the validated student name.
  * @throw invalid_argument If the provided name is empty.
  *
  * This method checks if the provided student name is empty. If it is, an exception
  * is thrown with a message indicating that the name cannot be empty. If the name is valid,
- * it is returned.
+ * the same view is returned, so no copy of the name is made.
  */
-string checkInput::checkName(string& n) {
-    string name;
-    name = n;
-
+string_view checkInput::checkName(string_view name) {
     if (name.empty()) {
         throw invalid_argument("Name cannot be empty. Please provide a valid Name.");
     }
@@ -60,3 +59,74 @@ int checkInput::checkRoll(int r) {
     return roll;
 }
 
+
+/**
+ * @brief Validates the section.
+ * @param section A view of the section to be validated.
+ * @return A view of the validated section.
+ * @throw invalid_argument If the section is longer than 8 characters or contains anything
+ * other than letters and digits.
+ */
+string_view checkInput::checkSection(string_view section) {
+    if (section.size() > 8) {
+        throw invalid_argument("Section cannot be longer than 8 characters. Please provide a valid Section.");
+    }
+
+    for (char c : section) {
+        if (!isalnum(static_cast<unsigned char>(c))) {
+            throw invalid_argument("Section can only contain letters and digits. Please provide a valid Section.");
+        }
+    }
+
+    return section;
+}
+
+/**
+ * @brief Validates the grade point average.
+ * @param grade The grade to be validated.
+ * @return The validated grade.
+ * @throw invalid_argument If the grade is outside 0.0 to 4.0.
+ */
+float checkInput::checkGrade(float grade) {
+    if (!(grade >= 0.0f && grade <= 4.0f)) {
+        throw invalid_argument("Grade must be between 0.0 and 4.0. Please provide a valid Grade.");
+    }
+
+    return grade;
+}
+
+/**
+ * @brief Validates the attendance.
+ * @param attendance The attendance, in percent, to be validated.
+ * @return The validated attendance.
+ * @throw invalid_argument If the attendance is outside 0 to 100.
+ */
+int checkInput::checkAttendance(int attendance) {
+    if (attendance < 0 || attendance > 100) {
+        throw invalid_argument("Attendance must be between 0 and 100. Please provide a valid Attendance.");
+    }
+
+    return attendance;
+}
+
+/**
+ * @brief Validates the enrollment date.
+ * @param date The date to be validated.
+ * @return The validated date.
+ * @throw invalid_argument If the date is neither all zero nor a real calendar date.
+ */
+Date checkInput::checkDate(const Date& date) {
+    if (date == Date{0, 0, 0}) {
+        return date;
+    }
+
+    static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (date.year % 4 == 0 && date.year % 100 != 0) || date.year % 400 == 0;
+
+    if (date.year < 1900 || date.year > 9999 || date.month < 1 || date.month > 12 || date.day < 1 ||
+        date.day > days[date.month - 1] + (date.month == 2 && leap ? 1 : 0)) {
+        throw invalid_argument("Enrollment date must be a valid YYYY-MM-DD date. Please provide a valid Date.");
+    }
+
+    return date;
+}
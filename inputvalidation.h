@@ -7,6 +7,8 @@
 #define INPUTVALIDATION_H
 
 #include <string>
+#include <string_view>
+#include "student.h"
 
 /**
  * @class checkInput
@@ -14,7 +16,8 @@
  *
  * This class includes static methods to validate the format and correctness of student
  * names and roll numbers. It does not store state information but offers utility methods
- * for input validation.
+ * for input validation. These methods are also the validators StudentSchema runs for each
+ * field.
  */
 class checkInput {
 private:
@@ -32,15 +35,15 @@ public:
     checkInput();
 
     /**
-     * @brief Validates and formats the student name.
-     * @param name A reference to the student name string to be validated.
-     * @return A validated and formatted student name.
+     * @brief Validates the student name.
+     * @param name A view of the student name to be validated.
+     * @return A view of the validated student name, referring to the same characters.
      *
-     * This static method takes a student name as input, validates it, and returns a
-     * formatted version of the name. It ensures that the name adheres to expected
-     * conventions and is free of invalid characters.
+     * This static method takes a student name as input, validates it, and returns it
+     * without copying. It ensures that the name adheres to expected conventions and is
+     * free of invalid characters.
      */
-    static std::string checkName(std::string& name);
+    static std::string_view checkName(std::string_view name);
 
     /**
      * @brief Validates the roll number.
@@ -52,6 +55,42 @@ public:
      * default or corrected value.
      */
     static int checkRoll(int roll);
+
+    /**
+     * @brief Validates the section.
+     * @param section A view of the section to be validated.
+     * @return A view of the validated section.
+     *
+     * A section is either empty (not assigned) or up to 8 letters and digits.
+     */
+    static std::string_view checkSection(std::string_view section);
+
+    /**
+     * @brief Validates the grade point average.
+     * @param grade The grade to be validated.
+     * @return The validated grade.
+     *
+     * A grade must lie between 0.0 and 4.0.
+     */
+    static float checkGrade(float grade);
+
+    /**
+     * @brief Validates the attendance.
+     * @param attendance The attendance, in percent, to be validated.
+     * @return The validated attendance.
+     *
+     * Attendance must lie between 0 and 100.
+     */
+    static int checkAttendance(int attendance);
+
+    /**
+     * @brief Validates the enrollment date.
+     * @param date The date to be validated.
+     * @return The validated date.
+     *
+     * A date is either all zero (unknown) or a real calendar date.
+     */
+    static Date checkDate(const Date& date);
 };
 
 #endif // INPUTVALIDATION_H
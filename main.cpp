@@ -4,6 +4,8 @@
  */
 
 #include <iostream>
+#include <string>
+#include <vector>
 #include "menu.h"
 
 using namespace std;
@@ -11,15 +13,30 @@ using namespace std;
 /**
  * @brief The entry point of the program.
  *
- * This function creates a `Menu` object and runs a loop to display the menu, accept user input,
- * and handle menu choices. It continuously prompts the user until the program is exited.
+ * This function creates a `Menu` object. When arguments are given they are run as a batch
+ * command (for example `stms query surnames 5`); otherwise it runs a loop to display the menu,
+ * accept user input, and handle menu choices until the program is exited. With
+ * `--record <trace>` every operation of the session is also recorded to a trace file.
  *
+ * @param argc The number of command-line arguments.
+ * @param argv The command-line arguments.
  * @return 0 on successful execution.
  */
-int main() {
+int main(int argc, char* argv[]) {
     int choice; /**< Variable to store the user's menu choice. */
     Menu menu; /**< Menu object to handle menu operations. */
 
+    // Record every operation to a trace file if asked to.
+    if (argc == 3 && string(argv[1]) == "--record") {
+        if (!menu.startRecording(argv[2])) {
+            cerr << "ERROR: Unable to create trace " << argv[2] << endl;
+            return 1;
+        }
+    } else if (argc > 1) {
+        // Run a batch command and exit if one was given.
+        return menu.runCommand(vector<string>(argv + 1, argv + argc));
+    }
+
     // Infinite loop to keep displaying the menu and handling choices.
     while (true) {
         menu.displaymenu(); // Display the menu options.
@@ -10,26 +10,110 @@
 #include "student.h"
 #include "filehandling.h"
 #include "inputvalidation.h"
+#include "studentstore.h"
+#include "studentschema.h"
+#include "nameindex.h"
+#include "aggregator.h"
+#include "replay.h"
+#include "trace.h"
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
 #include <vector>
 #include <cstdlib>
+#include <chrono>
+#include <memory>
+#include <thread>
 
 using namespace std;
 
+namespace {
+
+/**
+ * @brief Prompts for an optional student field and parses the answer into the student.
+ * @tparam Name The schema field to fill.
+ * @param prompt The text shown to the user.
+ * @param student The student that receives the value.
+ * @throw invalid_argument If the answer is not in the field's format.
+ *
+ * An empty answer leaves the field at its default value.
+ */
+template <FixedString Name>
+void promptField(const char* prompt, Student& student) {
+    string answer;
+    cout << prompt << endl;
+    getline(cin, answer);
+
+    if (!answer.empty() && !StudentSchema::parseField<Name>(answer, student)) {
+        throw invalid_argument("Invalid " + string(Name.view()) + ". Please provide a valid value.");
+    }
+}
+
+/**
+ * @brief Largest number of operations `replay zipf` generates; each one is held in memory.
+ */
+constexpr long long maxReplayOperations = 10000000;
+
+/**
+ * @brief Computes the largest thread count `replay` accepts.
+ * @return Four times the number of hardware threads, or 64 if that number is unknown.
+ *
+ * The replayer keeps one queue per thread for every barrier segment, so the count is bounded
+ * by what the machine can usefully run rather than by what fits in an unsigned.
+ */
+long long maxReplayThreads() {
+    unsigned hardware = thread::hardware_concurrency();
+    return hardware == 0 ? 64 : 4LL * hardware;
+}
+
+} // namespace
+
 /**
  * @brief Default constructor initializes a Menu object with a default choice value.
  *
  * This constructor sets the `choice` member variable to 0, representing no menu option selected.
+ * Nothing is read yet: "studentRec.txt" is loaded into the store by refresh() when the first
+ * operation needs it, so batch commands that work on their own copy of the data, such as
+ * `replay`, never load it twice. The name index is built lazily by loadNames().
  */
-Menu::Menu() : choice(0) {}
+Menu::Menu() : choice(0), namesLoaded(false) {}
+
+/**
+ * @brief Builds the name index from the store if it has not been built yet.
+ *
+ * Once built, the index is kept up to date by addStudent(), updateName() and removeStudent()
+ * instead of being rebuilt.
+ */
+void Menu::loadNames() {
+    if (namesLoaded) {
+        return;
+    }
+
+    store.snapshot().forEach([this](const Student& student) {
+        names.add(student.getRoll(), student.getName());
+    });
+    namesLoaded = true;
+}
+
+/**
+ * @brief Brings the store up to date with the student file.
+ *
+ * Other sessions may have changed the file since it was last read. If so, the store is
+ * reloaded and the name index is dropped, to be rebuilt by loadNames() when next needed.
+ */
+void Menu::refresh() {
+    if (store.refresh("studentRec.txt")) {
+        names.clear();
+        namesLoaded = false;
+    }
+}
 
 /**
  * @brief Displays the menu options to the user.
  *
  * This method prints the available menu options to the console, including options for
- * adding a student, viewing records, searching, updating names, removing students, and exiting.
+ * adding a student, viewing records, searching, updating names, removing students, fuzzy
+ * searching by name, statistics, and exiting.
  */
 void Menu::displaymenu() {
     cout << endl;
@@ -40,7 +124,9 @@ void Menu::displaymenu() {
     cout << "3. Search by Roll" << endl;
     cout << "4. Update Name" << endl;
     cout << "5. Remove student" << endl;
-    cout << "6. Exit" << endl;
+    cout << "6. Fuzzy search by Name" << endl;
+    cout << "7. Statistics" << endl;
+    cout << "8. Exit" << endl;
     cout << endl;
     cout << "Enter your choice: ";
 }
@@ -58,9 +144,12 @@ void Menu::getchoice(int c) {
 /**
  * @brief Adds a new student to the system.
  *
- * This method prompts the user for the student's name and roll number, validates the input,
- * creates a Student object, and appends the student's information to the file "studentRec.txt".
- * Any invalid input will result in an exception being caught and an error message being displayed.
+ * This method prompts the user for the student's name, roll number, section, grade,
+ * attendance and enrollment date, validates the input against StudentSchema, adds the
+ * student to the store, and appends the student's information to the file
+ * "studentRec.txt". The file is locked and the store brought up to date with it before the
+ * student is added. Any invalid input will result in an exception being caught and an error
+ * message being displayed.
  */
 void Menu::addStudent() {
     try {
@@ -74,14 +163,28 @@ void Menu::addStudent() {
         cin >> s_roll;
         cin.ignore();  // Clear the newline character from the input buffer
 
+        Student s1(s_name, s_roll);
+        promptField<"section">("Enter your section (leave empty if none): ", s1);
+        promptField<"grade">("Enter your grade point average (leave empty if none): ", s1);
+        promptField<"attendance">("Enter your attendance in percent (leave empty if none): ", s1);
+        promptField<"enrolled">("Enter your enrollment date as YYYY-MM-DD (leave empty if unknown): ", s1);
+
         // Validate inputs
-        string o_name = checkInput::checkName(s_name);
-        int o_roll = checkInput::checkRoll(s_roll);
+        StudentSchema::validate(s1);
+
+        // Publish the student and append to file
+        auto start = chrono::steady_clock::now();
+        FileLock lock("studentRec.txt");
+        refresh();
+        store.append(s1, "studentRec.txt");
 
-        // Create a Student object and append to file
-        Student s1(o_name, o_roll);
-        FileHandling filh("studentRec.txt");
-        filh.appendStudent(s1);
+        if (namesLoaded) {
+            names.add(s1.getRoll(), s1.getName());
+        }
+
+        if (trace) {
+            trace->record(TraceEvent(TraceOp::add, s1.getRoll(), 1, {}, s1), start);
+        }
 
         cout << "Successfully written" << endl;
     } catch (const invalid_argument& e) {
@@ -92,70 +195,70 @@ void Menu::addStudent() {
 /**
  * @brief Displays all student records.
  *
- * This method creates a FileHandling object to read and display all student records from the file
- * "studentRec.txt". It prints each record to the console.
+ * This method takes a snapshot of the store and prints a header with the schema's field
+ * names followed by every record in it. The listing is a consistent point-in-time view even
+ * if the store is modified while it is being printed.
  */
 void Menu::viewRecord() {
-    FileHandling record("studentRec.txt");
-    cout << "Student Name: " << setw(22) << "Roll number: " << endl;
-    record.readfile();
+    auto start = chrono::steady_clock::now();
+    refresh();
+    StudentStore::Snapshot view = store.snapshot();
+    for (string_view field : StudentSchema::names()) {
+        cout << field << " ";
+    }
+    cout << "\n";
+    view.forEach([](const Student& student) {
+        StudentSchema::format(cout, student);
+        cout << "\n";
+    });
+    cout << flush;
+
+    if (trace) {
+        trace->record(TraceEvent(TraceOp::view, -1, static_cast<uint32_t>(view.size())), start);
+    }
 }
 
 /**
  * @brief Searches for a student record by roll number.
  *
- * This method prompts the user for a roll number, searches the file "studentRec.txt" for
- * a record with the specified roll number, and displays the student's name if found.
+ * This method prompts the user for a roll number and displays the name of the first student
+ * with that roll number in the current snapshot of the store.
  */
 void Menu::search() {
-    string line;
-    string fname;
-    string lname;
-    int roll, sroll;
+    int sroll;
 
     cout << "Enter the roll number to search: " << endl;
     cin >> sroll;
     cin.ignore();  // Clear the newline character from the input buffer
 
-    ifstream file("studentRec.txt");
+    auto start = chrono::steady_clock::now();
+    refresh();
+    StudentStore::Snapshot view = store.snapshot();
+    const Student* student = view.find(sroll);
 
-    if (!file.is_open()) {
-        cout << "Unable to open the file" << endl;
-        return;
+    if (trace) {
+        trace->record(TraceEvent(TraceOp::search, sroll, student ? 1 : 0), start);
     }
 
-    while (getline(file, line)) {
-        stringstream content(line);
-        content >> fname >> lname >> roll;
-
-        if (roll == sroll) {
-            cout << fname << " " << lname << endl;
-            file.close();
-            return;
-        }
+    if (student) {
+        cout << student->getName() << endl;
+        return;
     }
-    file.close();
     cout << "Student with roll number " << sroll << " not found." << endl;
 }
 
 /**
  * @brief Updates the name of a student in the records.
  *
- * This method allows the user to update a student's name based on their roll number. It reads
- * from the original file "studentRec.txt", updates the relevant record, and writes the changes
- * to a temporary file. The original file is then replaced with the updated file.
+ * This method allows the user to update a student's name based on their roll number. The
+ * change is published to the store as a new version, and the file "studentRec.txt" is then
+ * rewritten through a temporary file that atomically replaces it. The file stays locked from
+ * reloading any changes made by other sessions until it has been rewritten, so those changes
+ * are kept.
  */
 void Menu::updateName() {
-    string fname, lname, fnew_fname, fnew_lname, file_context;
-    int roll, search_roll;
-
-    ifstream original_file("studentRec.txt");
-    ofstream temp_file("temp.txt");
-
-    if (!original_file.is_open() || !temp_file.is_open()) {
-        cout << "ERROR: Unable to open file." << endl;
-        return;
-    }
+    string fnew_fname, fnew_lname;
+    int search_roll;
 
     cout << "Enter the roll number to update the name: " << endl;
     cin >> search_roll;
@@ -169,22 +272,34 @@ void Menu::updateName() {
     cin >> fnew_lname;
     cin.ignore();  // Clear the newline character from the input buffer
 
-    while (getline(original_file, file_context)) {
-        stringstream line(file_context);
-        line >> fname >> lname >> roll;
+    string new_name = fnew_fname + " " + fnew_lname;
+
+    auto start = chrono::steady_clock::now();
+    FileLock lock("studentRec.txt");
+    refresh();
+    size_t renamed = store.rename(search_roll, new_name);
+    bool saved = true;
 
-        if (search_roll == roll) {
-            temp_file << fnew_fname << " " << fnew_lname << " " << roll << endl;
-        } else {
-            temp_file << fname << " " << lname << " " << roll << endl;
+    if (renamed > 0) {
+        if (namesLoaded) {
+            names.rename(search_roll, new_name);
         }
+        saved = store.save("studentRec.txt");
+    }
+
+    if (trace) {
+        trace->record(TraceEvent(TraceOp::update, search_roll, static_cast<uint32_t>(renamed), new_name), start);
     }
 
-    original_file.close();
-    temp_file.close();
+    if (renamed == 0) {
+        cout << "Student with roll number " << search_roll << " not found." << endl;
+        return;
+    }
 
-    remove("studentRec.txt");
-    rename("temp.txt", "studentRec.txt");
+    if (!saved) {
+        cout << "ERROR: Unable to open file." << endl;
+        return;
+    }
 
     cout << "Successfully updated" << endl;
 }
@@ -192,9 +307,11 @@ void Menu::updateName() {
 /**
  * @brief Removes a student record based on the student's name.
  *
- * This method prompts the user for the name of the student to be removed, reads the file
- * "studentRec.txt", and writes all records except the one with the specified name to a new
- * temporary file. The original file is then replaced with the updated file.
+ * This method prompts the user for the name of the student to be removed, removes every
+ * student whose name contains it from the store, and rewrites the file "studentRec.txt"
+ * through a temporary file that atomically replaces it. As in updateName(), the file is
+ * locked and reloaded first so that changes made by other sessions are kept, and it is left
+ * untouched when no student matches.
  */
 void Menu::removeStudent() {
     string stdname;
@@ -202,36 +319,381 @@ void Menu::removeStudent() {
     cin >> stdname;
     cin.ignore();  // Clear the newline character from the input buffer
 
-    ifstream readfile("studentRec.txt");
-    vector<string> lines;
-    string line;
+    auto start = chrono::steady_clock::now();
+    FileLock lock("studentRec.txt");
+    refresh();
+    vector<Student> removed = store.removeIf([&](const Student& student) {
+        return student.getName().find(stdname) != string_view::npos;
+    });
 
-    if (!readfile.is_open()) {
-        cout << "Error: Unable to open file." << endl;
-        return;
-    }
+    bool saved = true;
 
-    while (getline(readfile, line)) {
-        if (line.find(stdname) == string::npos) {
-            lines.push_back(line);
+    if (!removed.empty()) {
+        if (namesLoaded) {
+            for (const Student& student : removed) {
+                names.remove(student.getRoll(), student.getName());
+            }
         }
+        saved = store.save("studentRec.txt");
     }
 
-    readfile.close();
+    if (trace) {
+        trace->record(TraceEvent(TraceOp::remove, -1, static_cast<uint32_t>(removed.size()), stdname), start);
+    }
 
-    ofstream writefile("studentRec.txt");
+    if (removed.empty()) {
+        cout << "No student with a name containing \"" << stdname << "\" found." << endl;
+        return;
+    }
 
-    if (!writefile.is_open()) {
+    if (!saved) {
         cout << "ERROR: Unable to open file in write mode." << endl;
         return;
     }
 
-    for (const auto& updatedRecord : lines) {
-        writefile << updatedRecord << endl;
+    cout << "Student removed" << endl;
+}
+
+/**
+ * @brief Searches for students whose names are close to a possibly misspelled name.
+ *
+ * This method prompts the user for a name, looks it up in the trigram name index and prints
+ * the closest matches together with their roll numbers and edit distances.
+ */
+void Menu::fuzzySearch() {
+    string query;
+    cout << "Enter the name to search: " << endl;
+    getline(cin, query);
+
+    auto start = chrono::steady_clock::now();
+    refresh();
+    loadNames();
+
+    vector<NameMatch> matches = names.search(query, 5);
+
+    if (trace) {
+        trace->record(TraceEvent(TraceOp::fuzzy, -1, static_cast<uint32_t>(matches.size()), query), start);
+    }
+    if (matches.empty()) {
+        cout << "No student with a similar name found." << endl;
+        return;
     }
-    writefile.close();
 
-    cout << "Student removed" << endl;
+    for (const NameMatch& match : matches) {
+        cout << match.name << " " << match.roll << " (distance " << match.distance << ")" << endl;
+    }
+}
+
+/**
+ * @brief Prints the statistics of the student set.
+ *
+ * This method prints every statistic runQuery() supports, showing up to 10 entries of each list.
+ */
+void Menu::statistics() {
+    auto start = chrono::steady_clock::now();
+    runQuery("all", 10);
+
+    if (trace) {
+        trace->record(TraceEvent(TraceOp::statistics, -1, static_cast<uint32_t>(store.snapshot().size())), start);
+    }
+}
+
+/**
+ * @brief Runs an aggregation query over a snapshot of the store and prints the result.
+ * @param query One of count, distinct, minmax, duplicates, gaps, surnames, firstnames or all.
+ * @param k The maximum number of entries to print for each list.
+ * @return true if the query is known, false otherwise.
+ *
+ * Each statistic is computed in parallel by an Aggregator. The roll number and name passes
+ * are only run when the query needs them, and at most once each.
+ */
+bool Menu::runQuery(const string& query, size_t k) {
+    bool all = query == "all";
+    bool count = all || query == "count";
+    bool distinct = all || query == "distinct";
+    bool minmax = all || query == "minmax";
+    bool duplicates = all || query == "duplicates";
+    bool gaps = all || query == "gaps";
+    bool surnames = all || query == "surnames";
+    bool firstnames = all || query == "firstnames";
+
+    if (!(count || distinct || minmax || duplicates || gaps || surnames || firstnames)) {
+        return false;
+    }
+
+    refresh();
+    auto start = chrono::steady_clock::now();
+    StudentStore::Snapshot view = store.snapshot();
+    Aggregator aggregator(view);
+
+    RollStats rolls{0, 0, 0, 0, {}, {}};
+    if (count || distinct || minmax || duplicates || gaps) {
+        rolls = aggregator.rolls();
+    }
+
+    KeyStats fullNames{0, 0, {}};
+    if (distinct || duplicates) {
+        fullNames = aggregator.groupBy(Aggregator::NamePart::full, k);
+    }
+
+    if (count) {
+        cout << "Students: " << rolls.count << endl;
+    }
+    if (distinct) {
+        cout << "Distinct roll numbers: " << rolls.distinct << endl;
+        cout << "Distinct names: " << fullNames.distinct << endl;
+    }
+    if (minmax) {
+        cout << "Lowest roll number: " << rolls.min << endl;
+        cout << "Highest roll number: " << rolls.max << endl;
+    }
+    if (duplicates) {
+        cout << "Duplicate roll numbers: " << rolls.duplicates.size() << endl;
+        for (size_t i = 0; i < rolls.duplicates.size() && i < k; ++i) {
+            cout << "  " << rolls.duplicates[i] << endl;
+        }
+        cout << "Duplicate names: " << fullNames.repeated << endl;
+        for (const GroupCount& group : fullNames.top) {
+            if (group.count > 1) {
+                cout << "  " << group.key << " (" << group.count << ")" << endl;
+            }
+        }
+    }
+    if (gaps) {
+        cout << "Gaps in roll numbers: " << rolls.gaps.size() << endl;
+        for (size_t i = 0; i < rolls.gaps.size() && i < k; ++i) {
+            cout << "  " << rolls.gaps[i].first << "-" << rolls.gaps[i].second << endl;
+        }
+    }
+    if (surnames) {
+        cout << "Most common surnames:" << endl;
+        for (const GroupCount& group : aggregator.groupBy(Aggregator::NamePart::last, k).top) {
+            cout << "  " << group.key << " (" << group.count << ")" << endl;
+        }
+    }
+    if (firstnames) {
+        cout << "Most common first names:" << endl;
+        for (const GroupCount& group : aggregator.groupBy(Aggregator::NamePart::first, k).top) {
+            cout << "  " << group.key << " (" << group.count << ")" << endl;
+        }
+    }
+
+    auto elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start);
+    cout << "(" << view.size() << " records in " << elapsed.count() << " ms; " << view.pageCount() << " pages, "
+         << view.allocationCount() << " arena allocations, " << view.allocatedBytes() << " bytes)" << endl;
+    return true;
+}
+
+/**
+ * @brief Starts recording every operation to a trace file.
+ * @param filename The trace file to create.
+ * @return true if the file could be created, false otherwise.
+ *
+ * Each menu operation is recorded with its arguments, result and latency once it has run.
+ * The latency covers the work done on the store, the name index and the student file, but
+ * not the time spent waiting for input.
+ */
+bool Menu::startRecording(const string& filename) {
+    refresh();
+    trace = make_unique<TraceRecorder>(filename, store.snapshot());
+    if (!trace->good()) {
+        trace.reset();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Closes the trace file, if recording, with the final state of the store.
+ */
+void Menu::stopRecording() {
+    if (trace) {
+        trace->finish(store.snapshot());
+        trace.reset();
+    }
+}
+
+/**
+ * @brief Replays a trace or a synthetic workload against a copy of the student file.
+ * @param args The arguments after `replay`: the source and its options.
+ * @return The process exit status; 0 only if every check passed.
+ *
+ * The source is either a trace file written with `--record` or `zipf` for a synthetic
+ * workload. The student file is loaded into a separate store that is never saved, so the
+ * replay leaves the file untouched. The report lists throughput, latency percentiles per
+ * operation, how many results differed from the expected ones, and whether the final state
+ * of the store is the expected one. For a complete trace replayed against the data it was
+ * recorded on, the expected final state is also compared with the recorded one.
+ */
+int Menu::replay(const vector<string>& args) {
+    if (args.empty()) {
+        cerr << "Missing trace file or zipf" << endl;
+        return 1;
+    }
+
+    ReplayOptions options;
+    ZipfOptions zipf;
+    string data = "studentRec.txt";
+    bool dataGiven = false;
+
+    for (size_t i = 1; i < args.size(); i += 2) {
+        if (i + 1 >= args.size()) {
+            cerr << "Missing value for " << args[i] << endl;
+            return 1;
+        }
+        const string& value = args[i + 1];
+        try {
+            if (args[i] == "--threads") {
+                long long threads = stoll(value);
+                if (threads <= 0 || threads > maxReplayThreads()) {
+                    cerr << "--threads must be between 1 and " << maxReplayThreads() << endl;
+                    return 1;
+                }
+                options.threads = static_cast<unsigned>(threads);
+            } else if (args[i] == "--rate") {
+                options.rate = stod(value);
+            } else if (args[i] == "--data") {
+                data = value;
+                dataGiven = true;
+            } else if (args[i] == "--ops") {
+                long long operations = stoll(value);
+                if (operations <= 0 || operations > maxReplayOperations) {
+                    cerr << "--ops must be between 1 and " << maxReplayOperations << endl;
+                    return 1;
+                }
+                zipf.operations = static_cast<size_t>(operations);
+            } else if (args[i] == "--keys") {
+                zipf.keys = stoi(value);
+            } else if (args[i] == "--skew") {
+                zipf.skew = stod(value);
+            } else if (args[i] == "--seed") {
+                zipf.seed = stoull(value);
+            } else if (args[i] == "--mix") {
+                char comma;
+                istringstream mix(value);
+                if (!(mix >> zipf.add >> comma >> zipf.search >> comma >> zipf.update >> comma >> zipf.remove)) {
+                    throw invalid_argument(value);
+                }
+            } else {
+                cerr << "Unknown option: " << args[i] << endl;
+                return 1;
+            }
+        } catch (const exception&) {
+            cerr << "Invalid value for " << args[i] << ": " << value << endl;
+            return 1;
+        }
+    }
+
+    if (options.rate < 0 || zipf.keys < 1 || zipf.keys > 9999999 || zipf.skew < 0 ||
+        zipf.add + zipf.search + zipf.update + zipf.remove == 0) {
+        cerr << "Invalid replay options" << endl;
+        return 1;
+    }
+
+    StudentStore copy;
+    if (!copy.load(data) && dataGiven) {
+        cerr << "ERROR: Unable to open " << data << endl;
+        return 1;
+    }
+
+    Trace recorded;
+    vector<TraceEvent> events;
+    bool sameData = false;
+    if (args[0] == "zipf") {
+        events = Replayer::zipf(zipf);
+    } else {
+        if (!recorded.load(args[0])) {
+            cerr << "ERROR: Unable to read trace " << args[0] << endl;
+            return 1;
+        }
+        sameData = Trace::state(copy.snapshot()) == recorded.initial;
+        if (!sameData) {
+            cout << "Note: " << data << " differs from the data the trace was recorded on" << endl;
+        }
+        events = move(recorded.events);
+    }
+
+    ReplayReport report = Replayer(copy).run(events, options);
+
+    static const char* const opNames[traceOpCount] = {"end", "add", "view", "search", "update", "remove", "fuzzy",
+                                                      "statistics"};
+    auto row = [](const string& name, const LatencySummary& l) {
+        cout << left << setw(12) << name << right << setw(10) << l.count << fixed << setprecision(1);
+        for (uint64_t ns : {l.p50, l.p90, l.p99, l.p999, l.max}) {
+            cout << setw(12) << static_cast<double>(ns) / 1000.0;
+        }
+        cout << endl;
+    };
+
+    cout << "Replayed " << report.executed << " operations (" << report.skipped << " skipped) on "
+         << options.threads << " threads in " << fixed << setprecision(3) << report.seconds << " s: "
+         << setprecision(0) << static_cast<double>(report.executed) / max(report.seconds, 1e-9) << " ops/s" << endl;
+    cout << left << setw(12) << "operation" << right << setw(10) << "count" << setw(12) << "p50 us" << setw(12)
+         << "p90 us" << setw(12) << "p99 us" << setw(12) << "p99.9 us" << setw(12) << "max us" << endl;
+    for (size_t op = 0; op < traceOpCount; ++op) {
+        if (report.latency[op].count > 0) {
+            row(opNames[op], report.latency[op]);
+        }
+    }
+    row("all", report.overall);
+    cout << defaultfloat << setprecision(6);
+
+    bool ok = report.mismatches == 0 && report.actual == report.expected;
+    cout << "Results: " << report.checked << " checked, " << report.mismatches << " mismatched" << endl;
+    cout << "Final state: " << report.actual.students << " students, checksum " << hex << report.actual.checksum
+         << dec << (report.actual == report.expected ? " (as expected)" : " (MISMATCH)") << endl;
+    if (!(report.actual == report.expected)) {
+        cout << "Expected state: " << report.expected.students << " students, checksum " << hex
+             << report.expected.checksum << dec << endl;
+    }
+    StudentStore::Snapshot after = copy.snapshot();
+    cout << "Arena: " << after.pageCount() << " pages, " << after.allocationCount() << " allocations, "
+         << after.allocatedBytes() << " bytes" << endl;
+    if (sameData && recorded.complete) {
+        bool agrees = recorded.final == report.expected;
+        cout << "Recorded final state: " << (agrees ? "matches" : "MISMATCH") << endl;
+        ok = ok && agrees;
+    }
+
+    return ok ? 0 : 1;
+}
+
+/**
+ * @brief Runs a batch command instead of the interactive menu.
+ * @param args The command-line arguments, without the program name.
+ * @return The process exit status.
+ *
+ * Supported commands:
+ * - `query <name> [k]`: runs an aggregation query, see runQuery().
+ * - `replay <trace|zipf> [options]`: runs a load test, see replay().
+ */
+int Menu::runCommand(const vector<string>& args) {
+    if (args.size() >= 2 && args[0] == "query") {
+        size_t k = 10;
+        if (args.size() >= 3) {
+            try {
+                k = stoul(args[2]);
+            } catch (const exception&) {
+                cerr << "Invalid count: " << args[2] << endl;
+                return 1;
+            }
+        }
+        if (!runQuery(args[1], k)) {
+            cerr << "Unknown query: " << args[1] << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (!args.empty() && args[0] == "replay") {
+        return replay(vector<string>(args.begin() + 1, args.end()));
+    }
+
+    cerr << "Usage: stms query <count|distinct|minmax|duplicates|gaps|surnames|firstnames|all> [k]" << endl;
+    cerr << "       stms replay <trace|zipf> [--threads n] [--rate ops/s] [--data file] [--ops n] [--keys n]" << endl;
+    cerr << "                   [--skew s] [--mix add,search,update,remove] [--seed n]" << endl;
+    cerr << "       stms --record <trace>" << endl;
+    return 1;
 }
 
 /**
@@ -239,7 +701,7 @@ void Menu::removeStudent() {
  *
  * This method uses a switch-case structure to determine which operation to perform based on
  * the user's menu choice, including adding a student, viewing records, searching, updating
- * names, removing students, or exiting the application.
+ * names, removing students, fuzzy searching by name, statistics, or exiting the application.
  */
 void Menu::handlechoice() {
     switch (choice) {
@@ -259,6 +721,13 @@ void Menu::handlechoice() {
             removeStudent();
             break;
         case 6:
+            fuzzySearch();
+            break;
+        case 7:
+            statistics();
+            break;
+        case 8:
+            stopRecording();
             exit(0);
             break;
         default:
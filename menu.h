@@ -6,6 +6,14 @@
 #ifndef MENU_H
 #define MENU_H
 
+#include "nameindex.h"
+#include "studentstore.h"
+#include "trace.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
 /**
  * @class Menu
  * @brief Manages the user interface for interacting with the student management system.
@@ -17,13 +25,28 @@
 class Menu {
 private:
     int choice; /**< Stores the user's menu choice. */
+    StudentStore store; /**< The student set, loaded from the student file on first use. */
+    NameIndex names; /**< Trigram index over student names, built on first fuzzy search. */
+    bool namesLoaded; /**< Whether `names` reflects the store. */
+    std::unique_ptr<TraceRecorder> trace; /**< Records every operation; null when not recording. */
+
+    /**
+     * @brief Builds the name index from the store if it has not been built yet.
+     */
+    void loadNames();
+
+    /**
+     * @brief Reloads the store if another session changed the student file.
+     */
+    void refresh();
 
 public:
     /**
      * @brief Default constructor initializes a Menu object with default values.
      *
      * This constructor sets up an instance of Menu, initializing the `choice` member variable
-     * to a default value.
+     * to a default value. The student file and the name index are only loaded once an
+     * operation needs them.
      */
     Menu();
 
@@ -59,5 +82,82 @@ public:
     void addStudent();
 
     /**
-     * @brief Searches for a student rec
+     * @brief Searches for a student record by roll number.
+     *
+     * This method prompts the user for a roll number and displays the matching student's name.
+     */
+    void search();
+
+    /**
+     * @brief Updates the name of a student in the records.
+     *
+     * This method prompts the user for a roll number and a new name, publishes the change to
+     * the store and rewrites the student file.
+     */
+    void updateName();
+
+    /**
+     * @brief Removes a student from the records.
+     *
+     * This method prompts the user for a name and removes every student whose name contains it.
+     */
+    void removeStudent();
+
+    /**
+     * @brief Searches for students whose names are close to a possibly misspelled name.
+     *
+     * This method prompts the user for a name and lists the closest matches.
+     */
+    void fuzzySearch();
+
+    /**
+     * @brief Prints the statistics of the student set.
+     *
+     * This method prints counts, roll number range, duplicates, gaps and the most common
+     * names, computed in parallel over a snapshot of the store.
+     */
+    void statistics();
+
+    /**
+     * @brief Runs an aggregation query and prints the result.
+     * @param query One of count, distinct, minmax, duplicates, gaps, surnames, firstnames or all.
+     * @param k The maximum number of entries to print for each list.
+     * @return true if the query is known, false otherwise.
+     */
+    bool runQuery(const std::string& query, std::size_t k);
+
+    /**
+     * @brief Replays a trace or a synthetic workload against a copy of the student file.
+     * @param args The arguments after `replay`: the source and its options.
+     * @return The process exit status; 0 only if every check passed.
+     */
+    int replay(const std::vector<std::string>& args);
+
+    /**
+     * @brief Starts recording every operation to a trace file.
+     * @param filename The trace file to create.
+     * @return true if the file could be created, false otherwise.
+     */
+    bool startRecording(const std::string& filename);
+
+    /**
+     * @brief Closes the trace file, if recording, with the final state of the store.
+     */
+    void stopRecording();
+
+    /**
+     * @brief Runs a batch command instead of the interactive menu.
+     * @param args The command-line arguments, without the program name.
+     * @return The process exit status.
+     */
+    int runCommand(const std::vector<std::string>& args);
+
+    /**
+     * @brief Displays all student records.
+     *
+     * This method prints every record in a snapshot of the store.
+     */
+    void viewRecord();
+};
 
+#endif // MENU_H
@@ -0,0 +1,380 @@
+/**
+ * @file NameIndex.cpp
+ * @brief Implements the NameIndex class for typo-tolerant name search.
+ */
+
+#include "nameindex.h"
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Collects the distinct trigrams of a normalized name.
+ * @param normalized A name produced by NameIndex::normalize().
+ * @param grams Receives the trigrams, sorted and without duplicates.
+ *
+ * The name is padded with a space on each side so that the start and end of the name
+ * form grams of their own, which lets short names and single words still be found.
+ */
+void trigramsOf(const string& normalized, vector<uint32_t>& grams) {
+    grams.clear();
+    if (normalized.empty()) {
+        return;
+    }
+
+    string padded = " " + normalized + " ";
+    for (size_t i = 0; i + 3 <= padded.size(); ++i) {
+        grams.push_back(static_cast<uint32_t>(static_cast<unsigned char>(padded[i])) << 16 |
+                        static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8 |
+                        static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 2])));
+    }
+
+    sort(grams.begin(), grams.end());
+    grams.erase(unique(grams.begin(), grams.end()), grams.end());
+}
+
+/**
+ * @brief Appends an unsigned value as a little-endian base-128 varint.
+ * @param bytes The buffer to append to.
+ * @param value The value to encode.
+ */
+void appendVarint(vector<uint8_t>& bytes, uint32_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * @brief Decodes one varint.
+ * @param p The position to read from; advanced past the varint.
+ * @return The decoded value.
+ */
+uint32_t readVarint(const uint8_t*& p) {
+    uint32_t value = 0;
+    int shift = 0;
+    while (*p & 0x80) {
+        value |= static_cast<uint32_t>(*p++ & 0x7f) << shift;
+        shift += 7;
+    }
+    value |= static_cast<uint32_t>(*p++) << shift;
+    return value;
+}
+
+/**
+ * @brief Computes the Levenshtein distance between two strings.
+ * @param a The first string.
+ * @param b The second string.
+ * @param row Scratch space reused across calls.
+ * @return The minimum number of single-character edits turning `a` into `b`.
+ */
+int editDistance(string_view a, string_view b, vector<int>& row) {
+    row.resize(b.size() + 1);
+    for (size_t j = 0; j <= b.size(); ++j) {
+        row[j] = static_cast<int>(j);
+    }
+
+    for (size_t i = 1; i <= a.size(); ++i) {
+        int diagonal = row[0];
+        row[0] = static_cast<int>(i);
+        for (size_t j = 1; j <= b.size(); ++j) {
+            int above = row[j];
+            row[j] = min({row[j] + 1, row[j - 1] + 1, diagonal + (a[i - 1] == b[j - 1] ? 0 : 1)});
+            diagonal = above;
+        }
+    }
+
+    return row[b.size()];
+}
+
+/**
+ * @brief Computes how far a query is from a name, allowing the query to name only part of it.
+ * @param query A normalized query.
+ * @param name A normalized name.
+ * @param row Scratch space reused across calls.
+ * @return The smaller of the full edit distance and the edit distance to the closest run of
+ * consecutive words in `name` with as many words as `query`.
+ *
+ * This lets "smith" match "john smith" exactly, which full-string edit distance would not.
+ */
+int nameDistance(string_view query, string_view name, vector<int>& row) {
+    int best = editDistance(query, name, row);
+    size_t words = count(query.begin(), query.end(), ' ') + 1;
+
+    vector<size_t> starts{0};
+    for (size_t i = 0; i < name.size(); ++i) {
+        if (name[i] == ' ') {
+            starts.push_back(i + 1);
+        }
+    }
+
+    for (size_t w = 0; w + words <= starts.size(); ++w) {
+        size_t last = w + words;
+        size_t end = last < starts.size() ? starts[last] - 1 : name.size();
+        best = min(best, editDistance(query, name.substr(starts[w], end - starts[w]), row));
+    }
+
+    return best;
+}
+
+} // namespace
+
+/**
+ * @brief Default constructor creates an empty index.
+ */
+NameIndex::NameIndex() : dead(0) {}
+
+/**
+ * @brief Normalizes a name for indexing and comparison.
+ * @param name The name to normalize.
+ * @return The normalized name.
+ *
+ * ASCII letters are lower-cased, anything that is neither a letter, a digit nor part of a
+ * multi-byte character becomes a separator, and separators are collapsed to one space.
+ */
+string NameIndex::normalize(string_view name) {
+    string out;
+    out.reserve(name.size());
+
+    for (char c : name) {
+        unsigned char uc = static_cast<unsigned char>(c);
+        if (uc >= 0x80 || isalnum(uc)) {
+            out.push_back(static_cast<char>(tolower(uc)));
+        } else if (!out.empty() && out.back() != ' ') {
+            out.push_back(' ');
+        }
+    }
+
+    if (!out.empty() && out.back() == ' ') {
+        out.pop_back();
+    }
+    return out;
+}
+
+/**
+ * @brief Appends a new live entry and adds its id to the posting list of each trigram.
+ * @param roll The student's roll number.
+ * @param name The student's name.
+ *
+ * Ids are handed out in increasing order, so each posting list stays sorted and the new id
+ * is encoded as the gap from the previous one.
+ */
+void NameIndex::insert(int roll, string_view name) {
+    uint32_t id = static_cast<uint32_t>(entries.size());
+    entries.push_back({string(name), roll, true});
+    byRoll[roll].push_back(id);
+
+    vector<uint32_t> grams;
+    trigramsOf(normalize(name), grams);
+
+    for (uint32_t gram : grams) {
+        Posting& posting = postings[gram];
+        appendVarint(posting.bytes, posting.count == 0 ? id : id - posting.last);
+        posting.last = id;
+        ++posting.count;
+    }
+}
+
+/**
+ * @brief Marks an entry as dead; its id stays in the posting lists until compaction.
+ * @param id The entry to retire.
+ */
+void NameIndex::kill(uint32_t id) {
+    entries[id].live = false;
+    ++dead;
+}
+
+/**
+ * @brief Rebuilds the index from its live entries once half of them are dead.
+ */
+void NameIndex::compact() {
+    if (dead * 2 <= entries.size()) {
+        return;
+    }
+
+    vector<Entry> old = move(entries);
+    clear();
+
+    for (const Entry& entry : old) {
+        if (entry.live) {
+            insert(entry.roll, entry.name);
+        }
+    }
+}
+
+/**
+ * @brief Adds a student's name to the index.
+ * @param roll The student's roll number.
+ * @param name The student's name.
+ */
+void NameIndex::add(int roll, string_view name) {
+    insert(roll, name);
+}
+
+/**
+ * @brief Replaces the name of every entry with the given roll number.
+ * @param roll The roll number whose name changes.
+ * @param name The new name.
+ *
+ * The old entries are retired and the same number of entries is added under the new name.
+ */
+void NameIndex::rename(int roll, string_view name) {
+    auto it = byRoll.find(roll);
+    if (it == byRoll.end()) {
+        return;
+    }
+
+    vector<uint32_t> ids = move(it->second);
+    byRoll.erase(it);
+
+    for (uint32_t id : ids) {
+        kill(id);
+    }
+    for (size_t i = 0; i < ids.size(); ++i) {
+        insert(roll, name);
+    }
+
+    compact();
+}
+
+/**
+ * @brief Removes the entry with the given roll number and name.
+ * @param roll The roll number of the student.
+ * @param name The name of the student, as stored.
+ */
+void NameIndex::remove(int roll, string_view name) {
+    auto it = byRoll.find(roll);
+    if (it == byRoll.end()) {
+        return;
+    }
+
+    vector<uint32_t>& ids = it->second;
+    auto match = find_if(ids.begin(), ids.end(), [&](uint32_t id) { return entries[id].name == name; });
+    if (match == ids.end()) {
+        return;
+    }
+
+    kill(*match);
+    ids.erase(match);
+    if (ids.empty()) {
+        byRoll.erase(it);
+    }
+
+    compact();
+}
+
+/**
+ * @brief Removes every entry from the index.
+ */
+void NameIndex::clear() {
+    entries.clear();
+    postings.clear();
+    byRoll.clear();
+    dead = 0;
+}
+
+/**
+ * @brief Gets the number of live names in the index.
+ * @return The name count.
+ */
+size_t NameIndex::size() const {
+    return entries.size() - dead;
+}
+
+/**
+ * @brief Finds the names closest to the query.
+ * @param query The (possibly misspelled) name to look for.
+ * @param k The maximum number of results to return.
+ * @return Up to `k` matches, ordered by distance and then by shared trigrams.
+ *
+ * Posting lists are visited from the shortest to the longest until `maxScanned` entries have
+ * been decoded. Every live id counts one hit per shared trigram, and new ids stop being
+ * admitted after `maxGathered`. The `maxCandidates` ids with
+ * the most hits are then scored by edit distance, taking the best of the whole name and of
+ * any run of its words as long as the query.
+ */
+vector<NameMatch> NameIndex::search(string_view query, size_t k) const {
+    string target = normalize(query);
+    if (target.empty() || k == 0) {
+        return {};
+    }
+
+    vector<uint32_t> grams;
+    trigramsOf(target, grams);
+
+    vector<const Posting*> lists;
+    for (uint32_t gram : grams) {
+        auto it = postings.find(gram);
+        if (it != postings.end()) {
+            lists.push_back(&it->second);
+        }
+    }
+    sort(lists.begin(), lists.end(), [](const Posting* a, const Posting* b) { return a->count < b->count; });
+
+    unordered_map<uint32_t, uint32_t> hits;
+    uint32_t budget = maxScanned;
+    for (const Posting* posting : lists) {
+        if (budget == 0) {
+            break;
+        }
+
+        uint32_t scanned = min(posting->count, budget);
+        budget -= scanned;
+
+        const uint8_t* p = posting->bytes.data();
+        uint32_t id = 0;
+        for (uint32_t i = 0; i < scanned; ++i) {
+            id += readVarint(p);
+            if (!entries[id].live) {
+                continue;
+            }
+
+            auto hit = hits.find(id);
+            if (hit != hits.end()) {
+                ++hit->second;
+            } else if (hits.size() < maxGathered) {
+                hits.emplace(id, 1);
+            }
+        }
+    }
+
+    vector<pair<uint32_t, uint32_t>> candidates(hits.begin(), hits.end());
+    auto byHits = [](const pair<uint32_t, uint32_t>& a, const pair<uint32_t, uint32_t>& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    };
+    if (candidates.size() > maxCandidates) {
+        partial_sort(candidates.begin(), candidates.begin() + maxCandidates, candidates.end(), byHits);
+        candidates.resize(maxCandidates);
+    }
+
+    vector<pair<NameMatch, uint32_t>> scored;
+    vector<int> row;
+    for (const auto& [id, count] : candidates) {
+        const Entry& entry = entries[id];
+        scored.push_back({{entry.name, entry.roll, nameDistance(target, normalize(entry.name), row)}, count});
+    }
+
+    sort(scored.begin(), scored.end(), [](const auto& a, const auto& b) {
+        if (a.first.distance != b.first.distance) {
+            return a.first.distance < b.first.distance;
+        }
+        if (a.second != b.second) {
+            return a.second > b.second;
+        }
+        return a.first.name < b.first.name;
+    });
+
+    vector<NameMatch> matches;
+    for (size_t i = 0; i < scored.size() && i < k; ++i) {
+        matches.push_back(move(scored[i].first));
+    }
+    return matches;
+}
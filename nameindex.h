@@ -0,0 +1,144 @@
+/**
+ * @file NameIndex.h
+ * @brief Defines the NameIndex class for typo-tolerant name search.
+ */
+
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct NameMatch
+ * @brief One result of a fuzzy name search.
+ */
+struct NameMatch {
+    std::string name; /**< The student's name as stored. */
+    int roll; /**< The student's roll number. */
+    int distance; /**< Edit distance between the normalized query and the normalized name. */
+};
+
+/**
+ * @class NameIndex
+ * @brief A trigram inverted index over normalized student names.
+ *
+ * Names are lower-cased, punctuation is folded to spaces and runs of spaces are collapsed
+ * before the name is split into overlapping three-character grams. Each gram maps to a
+ * posting list of entry ids, stored as delta-encoded varints. A search gathers candidates
+ * from the rarest grams of the query first, keeps at most `maxCandidates` of them, and
+ * ranks those by edit distance, so the cost of a query is bounded by the candidate budget
+ * rather than by the number of names indexed.
+ *
+ * The index is updated in place: new names are appended to the posting lists, removed
+ * names are marked dead and skipped, and the lists are rebuilt once dead entries make up
+ * half of the index.
+ */
+class NameIndex {
+private:
+    /**
+     * @struct Entry
+     * @brief A name stored in the index.
+     */
+    struct Entry {
+        std::string name; /**< The name as given. */
+        int roll; /**< The roll number of the student. */
+        bool live; /**< False once the entry has been removed or renamed. */
+    };
+
+    /**
+     * @struct Posting
+     * @brief A compressed, ascending list of entry ids for one trigram.
+     */
+    struct Posting {
+        std::vector<std::uint8_t> bytes; /**< Varint-encoded gaps between consecutive ids. */
+        std::uint32_t last; /**< The last id appended, used to encode the next gap. */
+        std::uint32_t count; /**< Number of ids in the list. */
+    };
+
+    std::vector<Entry> entries; /**< All entries, indexed by id; ids only ever grow. */
+    std::unordered_map<std::uint32_t, Posting> postings; /**< Trigram to posting list. */
+    std::unordered_map<int, std::vector<std::uint32_t>> byRoll; /**< Roll number to live entry ids. */
+    std::size_t dead; /**< Number of entries that are no longer live. */
+
+    void insert(int roll, std::string_view name);
+    void kill(std::uint32_t id);
+    void compact();
+
+public:
+    /**
+     * @brief Upper bound on the number of names scored by edit distance per query.
+     */
+    static constexpr std::size_t maxCandidates = 256;
+
+    /**
+     * @brief Upper bound on the number of distinct names collected from posting lists.
+     */
+    static constexpr std::size_t maxGathered = 8192;
+
+    /**
+     * @brief Upper bound on the number of posting entries decoded per query.
+     *
+     * Lists are read rarest first, so the budget is spent on the grams that discriminate
+     * best; very common grams (such as the start of a popular first name) are cut short.
+     */
+    static constexpr std::uint32_t maxScanned = 1u << 17;
+
+    /**
+     * @brief Default constructor creates an empty index.
+     */
+    NameIndex();
+
+    /**
+     * @brief Adds a student's name to the index.
+     * @param roll The student's roll number.
+     * @param name The student's name.
+     */
+    void add(int roll, std::string_view name);
+
+    /**
+     * @brief Replaces the name of every entry with the given roll number.
+     * @param roll The roll number whose name changes.
+     * @param name The new name.
+     */
+    void rename(int roll, std::string_view name);
+
+    /**
+     * @brief Removes the entry with the given roll number and name.
+     * @param roll The roll number of the student.
+     * @param name The name of the student, as stored.
+     */
+    void remove(int roll, std::string_view name);
+
+    /**
+     * @brief Removes every entry from the index.
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of live names in the index.
+     * @return The name count.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Finds the names closest to the query.
+     * @param query The (possibly misspelled) name to look for.
+     * @param k The maximum number of results to return.
+     * @return Up to `k` matches, closest first.
+     */
+    std::vector<NameMatch> search(std::string_view query, std::size_t k) const;
+
+    /**
+     * @brief Normalizes a name for indexing and comparison.
+     * @param name The name to normalize.
+     * @return The name lower-cased, with punctuation folded to single spaces and trimmed.
+     */
+    static std::string normalize(std::string_view name);
+};
+
+#endif // NAMEINDEX_H
@@ -0,0 +1,378 @@
+/**
+ * @file Replay.cpp
+ * @brief Implements the Replayer class.
+ */
+
+#include "replay.h"
+#include "aggregator.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+/**
+ * @class Model
+ * @brief A plain, single-threaded copy of the student set used to compute expected results.
+ *
+ * Each operation is implemented directly on a vector with the same meaning as in
+ * StudentStore, so the model stays independent of the paging and versioning under test.
+ */
+class Model {
+public:
+    /**
+     * @brief Copies every student of a snapshot.
+     * @param view The snapshot.
+     */
+    explicit Model(const StudentStore::Snapshot& view) {
+        students.reserve(view.size());
+        view.forEach([this](const Student& student) {
+            students.push_back(student);
+        });
+    }
+
+    /**
+     * @brief Applies one operation.
+     * @param event The operation.
+     * @return The expected result of the operation.
+     */
+    uint32_t apply(const TraceEvent& event) {
+        switch (event.op) {
+            case TraceOp::add:
+                students.push_back(event.student);
+                return 1;
+            case TraceOp::search:
+                return any_of(students.begin(), students.end(), [&](const Student& s) {
+                    return s.getRoll() == event.roll;
+                }) ? 1 : 0;
+            case TraceOp::update: {
+                uint32_t renamed = 0;
+                for (Student& student : students) {
+                    if (student.getRoll() == event.roll) {
+                        student.setName(event.text);
+                        ++renamed;
+                    }
+                }
+                return renamed;
+            }
+            case TraceOp::remove:
+                return static_cast<uint32_t>(erase_if(students, [&](const Student& s) {
+                    return s.getName().find(event.text) != string_view::npos;
+                }));
+            default:
+                return static_cast<uint32_t>(students.size());
+        }
+    }
+
+    /**
+     * @brief Computes the state of the model.
+     * @return Its size and the sum of the checksums of its students.
+     */
+    TraceState state() const {
+        TraceState state;
+        for (const Student& student : students) {
+            ++state.students;
+            state.checksum += Trace::checksum(student);
+        }
+        return state;
+    }
+
+private:
+    vector<Student> students; /**< The students, in order. */
+};
+
+/**
+ * @brief Checks whether the result of an operation depends only on its own key.
+ * @param op The operation.
+ * @return true for add, search, update and remove.
+ */
+bool keyed(TraceOp op) {
+    return op == TraceOp::add || op == TraceOp::search || op == TraceOp::update || op == TraceOp::remove;
+}
+
+/**
+ * @brief Checks whether the replayer executes an operation.
+ * @param op The operation.
+ * @return false for fuzzy searches and the end marker.
+ */
+bool executable(TraceOp op) {
+    return op != TraceOp::fuzzy && op != TraceOp::end;
+}
+
+/**
+ * @brief Checks whether an operation must run alone, after everything before it.
+ * @param event The operation.
+ * @return true for removes without a key: their pattern may match students of any roll
+ * number, so they are ordered against every other operation.
+ */
+bool barrier(const TraceEvent& event) {
+    return event.op == TraceOp::remove && event.roll < 0;
+}
+
+/**
+ * @brief Marks a segment that is not closed by a barrier.
+ */
+constexpr size_t noBarrier = static_cast<size_t>(-1);
+
+/**
+ * @struct Segment
+ * @brief Operations that may run concurrently, followed by the barrier that ends them.
+ */
+struct Segment {
+    vector<vector<size_t>> queues; /**< Positions of the operations, one queue per thread. */
+    size_t barrier; /**< Position of the closing barrier, or `noBarrier`. */
+};
+
+/**
+ * @brief Picks the key that decides which thread runs an operation.
+ * @param event The operation.
+ * @param i The position of the operation; used for operations without a key.
+ * @return The key.
+ */
+uint64_t routingKey(const TraceEvent& event, size_t i) {
+    if (event.op == TraceOp::add) {
+        return static_cast<uint32_t>(event.student.getRoll());
+    }
+    if (keyed(event.op) && event.roll >= 0) {
+        return static_cast<uint32_t>(event.roll);
+    }
+    return i;
+}
+
+/**
+ * @brief Computes the latency percentiles of a set of samples.
+ * @param samples The latencies, in nanoseconds; sorted in place.
+ * @return The summary.
+ */
+LatencySummary summarize(vector<uint64_t>& samples) {
+    LatencySummary summary;
+    if (samples.empty()) {
+        return summary;
+    }
+
+    sort(samples.begin(), samples.end());
+    auto rank = [&](double q) {
+        size_t i = static_cast<size_t>(ceil(q * static_cast<double>(samples.size())));
+        return samples[min(samples.size(), max<size_t>(i, 1)) - 1];
+    };
+
+    summary.count = samples.size();
+    summary.p50 = rank(0.5);
+    summary.p90 = rank(0.9);
+    summary.p99 = rank(0.99);
+    summary.p999 = rank(0.999);
+    summary.max = samples.back();
+    return summary;
+}
+
+/**
+ * @brief Formats a roll number the way synthetic names and patterns contain it.
+ * @param roll The roll number.
+ * @return The roll number padded to 7 digits.
+ */
+string padded(int roll) {
+    char digits[16];
+    snprintf(digits, sizeof digits, "%07d", roll);
+    return digits;
+}
+
+} // namespace
+
+/**
+ * @brief Creates a replayer that runs operations against a store.
+ * @param s The store; it is modified by the replay.
+ */
+Replayer::Replayer(StudentStore& s) : store(s) {}
+
+/**
+ * @brief Replays operations and checks the results.
+ * @param events The operations, in order.
+ * @param options The number of threads and the target rate.
+ * @return Throughput, latency percentiles and the result of the checks.
+ *
+ * The expected results come from a Model run before the timed part. Each thread records its
+ * latencies in its own vectors, which are only merged once every thread has finished. Threads
+ * are started again after every barrier; with no barriers they are started once.
+ */
+ReplayReport Replayer::run(const vector<TraceEvent>& events, const ReplayOptions& options) {
+    const size_t n = max(1u, options.threads);
+    ReplayReport report;
+
+    vector<uint32_t> expected(events.size());
+    {
+        Model model(store.snapshot());
+        for (size_t i = 0; i < events.size(); ++i) {
+            if (executable(events[i].op)) {
+                expected[i] = model.apply(events[i]);
+            }
+        }
+        report.expected = model.state();
+    }
+
+    // Operations are split into segments at every barrier; within a segment they are queued
+    // per thread by key, and the barrier runs alone once every queue of its segment is done.
+    vector<Segment> segments(1, Segment{vector<vector<size_t>>(n), noBarrier});
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (!executable(events[i].op)) {
+            ++report.skipped;
+        } else if (barrier(events[i])) {
+            segments.back().barrier = i;
+            segments.push_back(Segment{vector<vector<size_t>>(n), noBarrier});
+        } else {
+            segments.back().queues[routingKey(events[i], i) % n].push_back(i);
+        }
+    }
+
+    vector<uint32_t> actual(events.size());
+    vector<array<vector<uint64_t>, traceOpCount>> latencies(n);
+    auto start = chrono::steady_clock::now();
+
+    auto runOne = [&](size_t t, size_t i) {
+        auto due = chrono::steady_clock::now();
+        if (options.rate > 0) {
+            due = start + chrono::duration_cast<chrono::steady_clock::duration>(
+                chrono::duration<double>(static_cast<double>(i) / options.rate));
+            this_thread::sleep_until(due);
+        }
+
+        actual[i] = execute(events[i]);
+        auto latency = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - due);
+        latencies[t][static_cast<size_t>(events[i].op)].push_back(static_cast<uint64_t>(latency.count()));
+    };
+
+    for (const Segment& segment : segments) {
+        auto worker = [&](size_t t) {
+            for (size_t i : segment.queues[t]) {
+                runOne(t, i);
+            }
+        };
+
+        vector<thread> workers;
+        for (size_t t = 1; t < n; ++t) {
+            if (!segment.queues[t].empty()) {
+                workers.emplace_back(worker, t);
+            }
+        }
+        worker(0);
+        for (thread& w : workers) {
+            w.join();
+        }
+
+        if (segment.barrier != noBarrier) {
+            runOne(0, segment.barrier);
+        }
+    }
+
+    report.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    vector<uint64_t> all;
+    for (size_t op = 0; op < traceOpCount; ++op) {
+        vector<uint64_t> samples;
+        for (size_t t = 0; t < n; ++t) {
+            samples.insert(samples.end(), latencies[t][op].begin(), latencies[t][op].end());
+        }
+        all.insert(all.end(), samples.begin(), samples.end());
+        report.latency[op] = summarize(samples);
+    }
+    report.executed = all.size();
+    report.overall = summarize(all);
+
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (executable(events[i].op) && keyed(events[i].op)) {
+            ++report.checked;
+            report.mismatches += actual[i] != expected[i] ? 1 : 0;
+        }
+    }
+    report.actual = Trace::state(store.snapshot());
+    return report;
+}
+
+/**
+ * @brief Runs one operation against the store.
+ * @param event The operation.
+ * @return The number of students found, added, renamed, removed or listed.
+ */
+uint32_t Replayer::execute(const TraceEvent& event) {
+    switch (event.op) {
+        case TraceOp::add:
+            store.add(event.student);
+            return 1;
+        case TraceOp::search:
+            return store.snapshot().find(event.roll) ? 1 : 0;
+        case TraceOp::update:
+            return static_cast<uint32_t>(store.rename(event.roll, event.text));
+        case TraceOp::remove:
+            return static_cast<uint32_t>(store.removeIf([&](const Student& student) {
+                return student.getName().find(event.text) != string_view::npos;
+            }).size());
+        case TraceOp::view: {
+            StudentStore::Snapshot view = store.snapshot();
+            size_t listed = 0;
+            view.forEach([&listed](const Student& student) {
+                listed += student.getName().empty() ? 0 : 1;
+            });
+            return static_cast<uint32_t>(listed);
+        }
+        case TraceOp::statistics: {
+            StudentStore::Snapshot view = store.snapshot();
+            return static_cast<uint32_t>(Aggregator(view, 1).rolls().count);
+        }
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Generates a synthetic workload.
+ * @param options The size, key distribution and operation mix of the workload.
+ * @return The operations, in order.
+ *
+ * Roll numbers are drawn by inverting the cumulative Zipf distribution with a binary search
+ * over a table of `keys` entries.
+ */
+vector<TraceEvent> Replayer::zipf(const ZipfOptions& options) {
+    mt19937_64 random(options.seed);
+    discrete_distribution<int> pickOp({static_cast<double>(options.add), static_cast<double>(options.search),
+                                       static_cast<double>(options.update), static_cast<double>(options.remove)});
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+    const TraceOp ops[] = {TraceOp::add, TraceOp::search, TraceOp::update, TraceOp::remove};
+
+    vector<double> cdf(static_cast<size_t>(max(options.keys, 1)));
+    double sum = 0;
+    for (size_t k = 0; k < cdf.size(); ++k) {
+        sum += 1.0 / pow(static_cast<double>(k + 1), options.skew);
+        cdf[k] = sum;
+    }
+
+    vector<TraceEvent> events(options.operations);
+    for (TraceEvent& event : events) {
+        size_t rank = static_cast<size_t>(upper_bound(cdf.begin(), cdf.end(), uniform(random) * sum) - cdf.begin());
+        int roll = static_cast<int>(min(rank, cdf.size() - 1)) + 1;
+
+        event.op = ops[pickOp(random)];
+        event.roll = roll;
+        switch (event.op) {
+            case TraceOp::add:
+                event.student = Student("Load " + padded(roll), roll);
+                break;
+            case TraceOp::update:
+                event.text = "Moved " + padded(roll);
+                break;
+            case TraceOp::remove:
+                event.text = padded(roll);
+                break;
+            default:
+                break;
+        }
+    }
+    return events;
+}
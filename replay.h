@@ -0,0 +1,126 @@
+/**
+ * @file Replay.h
+ * @brief Defines the Replayer class, which re-executes traced or synthetic operations as a load test.
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "studentstore.h"
+#include "trace.h"
+
+/**
+ * @struct ReplayOptions
+ * @brief How a replay is run.
+ */
+struct ReplayOptions {
+    unsigned threads = 1; /**< Number of threads issuing operations. */
+    double rate = 0; /**< Target operations per second over all threads; 0 runs unthrottled. */
+};
+
+/**
+ * @struct ZipfOptions
+ * @brief Shape of a synthetic workload.
+ *
+ * Operations pick their roll number from 1 to `keys` with a Zipf distribution, so a few
+ * students receive most of the traffic. Synthetic students are named after their roll number
+ * (`Load 0000042`, renamed to `Moved 0000042`) and removed by that number, so every
+ * operation acts on its own roll number only.
+ */
+struct ZipfOptions {
+    std::size_t operations = 100000; /**< Number of operations to generate. */
+    int keys = 10000; /**< Number of distinct roll numbers, at most 9999999. */
+    double skew = 0.99; /**< Zipf exponent; 0 is uniform, larger values are more skewed. */
+    unsigned add = 10; /**< Relative weight of add operations. */
+    unsigned search = 70; /**< Relative weight of search operations. */
+    unsigned update = 15; /**< Relative weight of update operations. */
+    unsigned remove = 5; /**< Relative weight of remove operations. */
+    std::uint64_t seed = 1; /**< Seed of the random generator; equal seeds give equal workloads. */
+};
+
+/**
+ * @struct LatencySummary
+ * @brief Latency percentiles of one kind of operation, in nanoseconds.
+ */
+struct LatencySummary {
+    std::size_t count = 0; /**< Number of operations. */
+    std::uint64_t p50 = 0; /**< Median latency. */
+    std::uint64_t p90 = 0; /**< 90th percentile latency. */
+    std::uint64_t p99 = 0; /**< 99th percentile latency. */
+    std::uint64_t p999 = 0; /**< 99.9th percentile latency. */
+    std::uint64_t max = 0; /**< Largest latency. */
+};
+
+/**
+ * @struct ReplayReport
+ * @brief Outcome of a replay.
+ */
+struct ReplayReport {
+    std::size_t executed = 0; /**< Number of operations executed. */
+    std::size_t skipped = 0; /**< Number of operations the replayer does not execute. */
+    double seconds = 0; /**< Wall-clock duration of the replay. */
+    std::array<LatencySummary, traceOpCount> latency{}; /**< Latencies per TraceOp. */
+    LatencySummary overall; /**< Latencies over all executed operations. */
+    std::size_t checked = 0; /**< Number of results compared with the expected results. */
+    std::size_t mismatches = 0; /**< Number of results that differed from the expected results. */
+    TraceState expected; /**< The state the store should end up in. */
+    TraceState actual; /**< The state the store ended up in. */
+};
+
+/**
+ * @class Replayer
+ * @brief Runs a sequence of operations against a StudentStore and measures them.
+ *
+ * Operations are spread over the threads by key: every operation on one roll number runs
+ * on the same thread, in sequence order, while operations on different roll numbers run
+ * concurrently. A remove without a roll number, as recorded from the menu, may touch any
+ * key, so it acts as a barrier: it runs alone once every earlier operation has finished,
+ * and later operations start only after it.
+ *
+ * With a target rate, operation `i` is due `i / rate` seconds after the start regardless
+ * of which thread runs it, and its latency is measured from that due time, so a thread
+ * that falls behind shows up as queueing delay instead of a lower request rate.
+ *
+ * Before the timed run the operations are applied in order to a plain copy of the students,
+ * which gives the expected result of every keyed operation and the expected final state.
+ * Since operations on one key keep their order and barriers keep theirs relative to
+ * everything, the expected values hold for any number of threads.
+ *
+ * Add, search, update and remove run the same StudentStore calls as the menu, without
+ * writing the student file. View lists a snapshot, statistics computes the roll number
+ * statistics on the replaying thread, and fuzzy searches are skipped.
+ */
+class Replayer {
+public:
+    /**
+     * @brief Creates a replayer that runs operations against a store.
+     * @param s The store; it is modified by the replay.
+     */
+    explicit Replayer(StudentStore& s);
+
+    /**
+     * @brief Replays operations and checks the results.
+     * @param events The operations, in order.
+     * @param options The number of threads and the target rate.
+     * @return Throughput, latency percentiles and the result of the checks.
+     */
+    ReplayReport run(const std::vector<TraceEvent>& events, const ReplayOptions& options);
+
+    /**
+     * @brief Generates a synthetic workload.
+     * @param options The size, key distribution and operation mix of the workload.
+     * @return The operations, in order.
+     */
+    static std::vector<TraceEvent> zipf(const ZipfOptions& options);
+
+private:
+    StudentStore& store; /**< The store operations run against. */
+
+    std::uint32_t execute(const TraceEvent& event);
+};
+
+#endif // REPLAY_H
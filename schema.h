@@ -0,0 +1,639 @@
+/**
+ * @file Schema.h
+ * @brief Defines the compile-time record schema used to serialize, parse, validate and
+ * project records.
+ *
+ * A schema lists the fields of a record type in file order. Everything it generates is
+ * resolved at compile time: field lookup by name, the packed binary layout and its offsets,
+ * the text format, validation and column projection. There is no virtual dispatch and no
+ * runtime reflection.
+ */
+
+#ifndef SCHEMA_H
+#define SCHEMA_H
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct FixedString
+ * @brief A string literal usable as a template argument, used for field names.
+ */
+template <std::size_t N>
+struct FixedString {
+    char value[N]; /**< The characters, including the terminating null. */
+
+    /**
+     * @brief Captures a string literal.
+     * @param s The literal.
+     */
+    constexpr FixedString(const char (&s)[N]) {
+        for (std::size_t i = 0; i < N; ++i) {
+            value[i] = s[i];
+        }
+    }
+
+    /**
+     * @brief Gets the name as a view, without the terminating null.
+     * @return The view.
+     */
+    constexpr std::string_view view() const {
+        return std::string_view(value, N - 1);
+    }
+};
+
+/**
+ * @brief Field flag: the field may span several whitespace-separated words.
+ *
+ * At most one field of a schema may be a text field; it takes every word not claimed by
+ * the other fields.
+ */
+inline constexpr unsigned fieldText = 1u;
+
+/**
+ * @brief Field flag: the field may be missing from a line and keeps its default value.
+ *
+ * Optional fields must come after all required fields. This lets files written before the
+ * field existed still be read.
+ */
+inline constexpr unsigned fieldOptional = 2u;
+
+/**
+ * @struct FieldCodec
+ * @brief Converts one field type to and from its text and packed binary forms.
+ *
+ * Each specialization provides:
+ * - `parse(std::string_view, T&)`: reads the text form, returns false on error;
+ * - `format(std::ostream&, const T&)`: writes the text form, never empty or containing spaces
+ *   unless the field is a text field;
+ * - `packedSize`, `pack(char*, const T&, std::string& heap)` and
+ *   `unpack(const char*, std::string_view heap, T&)` for the fixed-width binary form;
+ * - `column_type` and `toColumn(const T&)` for column projections.
+ */
+template <typename T>
+struct FieldCodec;
+
+template <>
+struct FieldCodec<int> {
+    using column_type = int;
+    static constexpr std::size_t packedSize = sizeof(std::int32_t);
+
+    static bool parse(std::string_view text, int& value) {
+        auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+
+    static void format(std::ostream& out, int value) {
+        out << value;
+    }
+
+    static void pack(char* out, int value, std::string&) {
+        std::int32_t v = value;
+        std::memcpy(out, &v, sizeof v);
+    }
+
+    static bool unpack(const char* in, std::string_view, int& value) {
+        std::int32_t v;
+        std::memcpy(&v, in, sizeof v);
+        value = v;
+        return true;
+    }
+
+    static int toColumn(int value) {
+        return value;
+    }
+};
+
+template <>
+struct FieldCodec<float> {
+    using column_type = float;
+    static constexpr std::size_t packedSize = sizeof(float);
+
+    static bool parse(std::string_view text, float& value) {
+        auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+
+    static void format(std::ostream& out, float value) {
+        out << value;
+    }
+
+    static void pack(char* out, float value, std::string&) {
+        std::memcpy(out, &value, sizeof value);
+    }
+
+    static bool unpack(const char* in, std::string_view, float& value) {
+        std::memcpy(&value, in, sizeof value);
+        return true;
+    }
+
+    static float toColumn(float value) {
+        return value;
+    }
+};
+
+/**
+ * @brief Strings are written as is; an empty string is written as "-" so that it still
+ * occupies one word. In the packed form they are an offset and a length into a side heap,
+ * and in a column projection they are views of the record's own storage.
+ */
+template <>
+struct FieldCodec<std::pmr::string> {
+    using column_type = std::string_view;
+    static constexpr std::size_t packedSize = 2 * sizeof(std::uint32_t);
+
+    static bool parse(std::string_view text, std::pmr::string& value) {
+        if (text == "-") {
+            value.clear();
+        } else {
+            value.assign(text.data(), text.size());
+        }
+        return true;
+    }
+
+    static void format(std::ostream& out, const std::pmr::string& value) {
+        if (value.empty()) {
+            out << '-';
+        } else {
+            out << value;
+        }
+    }
+
+    static void pack(char* out, const std::pmr::string& value, std::string& heap) {
+        std::uint32_t span[2] = {static_cast<std::uint32_t>(heap.size()), static_cast<std::uint32_t>(value.size())};
+        heap.append(value.data(), value.size());
+        std::memcpy(out, span, sizeof span);
+    }
+
+    static bool unpack(const char* in, std::string_view heap, std::pmr::string& value) {
+        std::uint32_t span[2];
+        std::memcpy(span, in, sizeof span);
+        if (span[0] > heap.size() || span[1] > heap.size() - span[0]) {
+            return false;
+        }
+        value.assign(heap.data() + span[0], span[1]);
+        return true;
+    }
+
+    static std::string_view toColumn(const std::pmr::string& value) {
+        return value;
+    }
+};
+
+/**
+ * @struct Field
+ * @brief Describes one field of a record: its name, where it lives, how it is read and how
+ * it is validated.
+ * @tparam Name The field name.
+ * @tparam Member Pointer to the data member holding the field.
+ * @tparam Flags A combination of `fieldText` and `fieldOptional`.
+ * @tparam Validator A function called with the field value that throws
+ * `std::invalid_argument` if the value is not acceptable, or nullptr for none.
+ */
+template <FixedString Name, auto Member, unsigned Flags = 0, auto Validator = nullptr>
+struct Field;
+
+template <FixedString Name, typename Owner, typename T, T Owner::*Member, unsigned Flags, auto Validator>
+struct Field<Name, Member, Flags, Validator> {
+    using owner_type = Owner;
+    using value_type = T;
+    using codec = FieldCodec<T>;
+
+    static constexpr std::string_view name = Name.view();
+    static constexpr bool text = (Flags & fieldText) != 0;
+    static constexpr bool optional = (Flags & fieldOptional) != 0;
+
+    static const T& get(const Owner& owner) {
+        return owner.*Member;
+    }
+
+    static T& get(Owner& owner) {
+        return owner.*Member;
+    }
+
+    static void validate(const Owner& owner) {
+        if constexpr (!std::is_same_v<decltype(Validator), std::nullptr_t>) {
+            Validator(owner.*Member);
+        }
+    }
+};
+
+/**
+ * @class Schema
+ * @brief The list of fields of a record type, and everything generated from it.
+ * @tparam Owner The record type.
+ * @tparam Fields The fields, in file order.
+ *
+ * The text form of a record is its fields in order, separated by single spaces. The text
+ * field, if any, takes as many words as are left over, so it may contain spaces. Trailing
+ * optional fields may be missing, in which case they are reset to their default value.
+ */
+template <typename Owner, typename... Fields>
+class Schema {
+public:
+    using owner_type = Owner;
+    using fields = std::tuple<Fields...>;
+
+    template <std::size_t I>
+    using field = std::tuple_element_t<I, fields>;
+
+    static constexpr std::size_t fieldCount = sizeof...(Fields);
+
+    /**
+     * @brief Number of fields that must be present in every line.
+     */
+    static constexpr std::size_t requiredCount = ((Fields::optional ? 0 : 1) + ...);
+
+    /**
+     * @brief Maximum number of words a line may have.
+     */
+    static constexpr std::size_t maxWords = 64;
+
+private:
+    static constexpr bool optionalFieldsTrail() {
+        bool seenOptional = false;
+        bool ok = true;
+        ((ok = ok && !(seenOptional && !Fields::optional), seenOptional = seenOptional || Fields::optional), ...);
+        return ok;
+    }
+
+    static_assert(((Fields::text ? 1 : 0) + ...) <= 1, "a schema may have at most one text field");
+    static_assert(optionalFieldsTrail(), "optional fields must follow all required fields");
+
+    static constexpr std::array<std::size_t, fieldCount + 1> layout() {
+        std::array<std::size_t, fieldCount + 1> offsets{};
+        std::size_t sizes[] = {Fields::codec::packedSize...};
+        for (std::size_t i = 0; i < fieldCount; ++i) {
+            offsets[i + 1] = offsets[i] + sizes[i];
+        }
+        return offsets;
+    }
+
+    /**
+     * @struct Word
+     * @brief Position of one whitespace-separated word within a line.
+     *
+     * Deliberately trivial, so that the word array in parse() is left uninitialized.
+     */
+    struct Word {
+        std::size_t begin; /**< Offset of the first character. */
+        std::size_t end; /**< Offset one past the last character. */
+    };
+
+    static constexpr bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    /**
+     * @brief Parses the first `used` fields from the words of a line.
+     */
+    template <std::size_t... I>
+    static bool parseFields(std::string_view line, const Word* words, std::size_t count,
+                            std::size_t used, Owner& owner, std::index_sequence<I...>) {
+        if (count < used || (textIndex >= used && count != used)) {
+            return false;
+        }
+
+        std::size_t spare = count - used;
+        std::size_t next = 0;
+        bool ok = true;
+
+        auto parseOne = [&](auto tag) {
+            using F = field<decltype(tag)::value>;
+            constexpr std::size_t index = decltype(tag)::value;
+
+            if (!ok) {
+                return;
+            }
+            if (index >= used) {
+                F::get(owner) = {};
+                return;
+            }
+
+            std::size_t span = 1;
+            if constexpr (F::text) {
+                span += spare;
+            }
+
+            std::size_t begin = words[next].begin;
+            std::size_t end = words[next + span - 1].end;
+            ok = F::codec::parse(line.substr(begin, end - begin), F::get(owner));
+            next += span;
+        };
+
+        (parseOne(std::integral_constant<std::size_t, I>{}), ...);
+        return ok;
+    }
+
+    /**
+     * @brief Checks a record with validate() without throwing.
+     * @param owner The record.
+     * @return true if every field is acceptable.
+     */
+    static bool valid(const Owner& owner) {
+        try {
+            validate(owner);
+            return true;
+        } catch (const std::invalid_argument&) {
+            return false;
+        }
+    }
+
+    /**
+     * @brief Position of the text field, or `fieldCount` if there is none.
+     */
+    static constexpr std::size_t textIndex = [] {
+        std::size_t index = 0;
+        bool found = ((Fields::text ? true : (++index, false)) || ...);
+        return found ? index : fieldCount;
+    }();
+
+    template <FixedString Name, std::size_t... I>
+    static constexpr std::size_t find(std::index_sequence<I...>) {
+        std::size_t index = fieldCount;
+        ((index = (index == fieldCount && field<I>::name == Name.view()) ? I : index), ...);
+        return index;
+    }
+
+public:
+    /**
+     * @brief Byte offset of each field in the packed form; the last entry is the total size.
+     */
+    static constexpr std::array<std::size_t, fieldCount + 1> offsets = layout();
+
+    /**
+     * @brief Size in bytes of one record in the packed form, excluding its string heap.
+     */
+    static constexpr std::size_t packedSize = offsets[fieldCount];
+
+    /**
+     * @brief Position of the field with the given name.
+     *
+     * Naming a field that does not exist is a compile-time error.
+     */
+    template <FixedString Name>
+    static constexpr std::size_t indexOf() {
+        constexpr std::size_t index = find<Name>(std::make_index_sequence<fieldCount>{});
+        static_assert(index < fieldCount, "no field with this name");
+        return index;
+    }
+
+    /**
+     * @brief Gets the names of all fields, in order.
+     * @return The names.
+     */
+    static constexpr std::array<std::string_view, fieldCount> names() {
+        return {Fields::name...};
+    }
+
+    /**
+     * @brief Writes the text form of a record, without a line terminator.
+     * @param out The stream to write to.
+     * @param owner The record.
+     */
+    static void format(std::ostream& out, const Owner& owner) {
+        bool first = true;
+        ((out << (first ? "" : " "), Fields::codec::format(out, Fields::get(owner)), first = false), ...);
+    }
+
+    /**
+     * @brief Parses the text form of a record.
+     * @param line The line to parse; surrounding whitespace and a carriage return are ignored.
+     * @param owner The record that receives the values. It may be partly overwritten even
+     * when parsing fails.
+     * @return true if the line holds every required field and passes validate(), false
+     * otherwise.
+     *
+     * The line is first read with every field present, which is how format() writes it, and
+     * then with only the required fields, which is how files written before the optional
+     * fields existed look. Only if neither reading parses and validates is it read with
+     * one trailing optional field fewer each time. Trying the required-only reading second
+     * keeps a number at the end of an old name, as in `Louis 14 8`, from being taken as an
+     * optional field. Missing optional fields are left at their default value.
+     */
+    static bool parse(std::string_view line, Owner& owner) {
+        Word words[maxWords];
+        std::size_t count = 0;
+        std::size_t pos = 0;
+
+        while (true) {
+            while (pos < line.size() && isSpace(line[pos])) {
+                ++pos;
+            }
+            if (pos == line.size()) {
+                break;
+            }
+            if (count == maxWords) {
+                return false;
+            }
+            words[count].begin = pos;
+            while (pos < line.size() && !isSpace(line[pos])) {
+                ++pos;
+            }
+            words[count++].end = pos;
+        }
+
+        auto reads = [&](std::size_t used) {
+            return used > 0 && parseFields(line, words, count, used, owner, std::make_index_sequence<fieldCount>{}) &&
+                   valid(owner);
+        };
+
+        if (reads(fieldCount) || (requiredCount < fieldCount && reads(requiredCount))) {
+            return true;
+        }
+        for (std::size_t used = fieldCount - 1; used > requiredCount; --used) {
+            if (reads(used)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Parses the text form of a single field.
+     * @tparam Name The name of the field.
+     * @param text The text to parse.
+     * @param owner The record that receives the value.
+     * @return true if the text is a valid value for the field.
+     */
+    template <FixedString Name>
+    static bool parseField(std::string_view text, Owner& owner) {
+        using F = field<indexOf<Name>()>;
+        return F::codec::parse(text, F::get(owner));
+    }
+
+    /**
+     * @brief Runs the validator of every field.
+     * @param owner The record to validate.
+     * @throw std::invalid_argument From the first field whose value is not acceptable.
+     */
+    static void validate(const Owner& owner) {
+        (Fields::validate(owner), ...);
+    }
+
+    /**
+     * @brief Writes the packed form of a record.
+     * @param row Receives `packedSize` bytes.
+     * @param owner The record.
+     * @param heap Receives the characters of string fields, which `row` refers to by offset.
+     */
+    static void pack(char* row, const Owner& owner, std::string& heap) {
+        packFields(row, owner, heap, std::make_index_sequence<fieldCount>{});
+    }
+
+    /**
+     * @brief Reads the packed form of a record.
+     * @param row The `packedSize` bytes written by pack().
+     * @param heap The heap written by pack().
+     * @param owner The record that receives the values.
+     * @return false if a string field refers outside of `heap`.
+     */
+    static bool unpack(const char* row, std::string_view heap, Owner& owner) {
+        return unpackFields(row, heap, owner, std::make_index_sequence<fieldCount>{});
+    }
+
+private:
+    template <std::size_t... I>
+    static void packFields(char* row, const Owner& owner, std::string& heap, std::index_sequence<I...>) {
+        (field<I>::codec::pack(row + offsets[I], field<I>::get(owner), heap), ...);
+    }
+
+    template <std::size_t... I>
+    static bool unpackFields(const char* row, std::string_view heap, Owner& owner, std::index_sequence<I...>) {
+        return (field<I>::codec::unpack(row + offsets[I], heap, field<I>::get(owner)) && ...);
+    }
+};
+
+/**
+ * @class Columns
+ * @brief Column-wise storage for some fields of a schema.
+ * @tparam S The schema.
+ * @tparam Names The fields to keep; all fields when empty.
+ *
+ * Each kept field is stored in its own contiguous vector, so a pass over one field reads
+ * only that field and adding fields to the schema does not slow it down. String fields are
+ * stored as views of the records they were taken from, which must outlive the columns.
+ */
+template <typename S, FixedString... Names>
+class Columns {
+private:
+    template <std::size_t... I>
+    static constexpr auto allIndices(std::index_sequence<I...>) {
+        return std::array<std::size_t, sizeof...(I)>{I...};
+    }
+
+    static constexpr auto indices() {
+        if constexpr (sizeof...(Names) == 0) {
+            return allIndices(std::make_index_sequence<S::fieldCount>{});
+        } else {
+            return std::array<std::size_t, sizeof...(Names)>{S::template indexOf<Names>()...};
+        }
+    }
+
+    static constexpr auto kept = indices();
+
+    template <std::size_t K>
+    using column_type = typename S::template field<kept[K]>::codec::column_type;
+
+    template <std::size_t... K>
+    static auto makeStorage(std::index_sequence<K...>) -> std::tuple<std::vector<column_type<K>>...>;
+
+    using sequence = std::make_index_sequence<kept.size()>;
+    decltype(makeStorage(sequence{})) storage; /**< One vector per kept field. */
+
+    template <std::size_t... K>
+    void appendFields(const typename S::owner_type& owner, std::index_sequence<K...>) {
+        (std::get<K>(storage).push_back(S::template field<kept[K]>::codec::toColumn(S::template field<kept[K]>::get(owner))), ...);
+    }
+
+    template <std::size_t... K>
+    void reserveFields(std::size_t n, std::index_sequence<K...>) {
+        (std::get<K>(storage).reserve(n), ...);
+    }
+
+    template <std::size_t... K>
+    void clearFields(std::index_sequence<K...>) {
+        (std::get<K>(storage).clear(), ...);
+    }
+
+    template <FixedString Name>
+    static constexpr std::size_t position() {
+        constexpr std::size_t index = S::template indexOf<Name>();
+        for (std::size_t k = 0; k < kept.size(); ++k) {
+            if (kept[k] == index) {
+                return k;
+            }
+        }
+        return kept.size();
+    }
+
+public:
+    /**
+     * @brief Appends the kept fields of a record.
+     * @param owner The record.
+     */
+    void append(const typename S::owner_type& owner) {
+        appendFields(owner, sequence{});
+    }
+
+    /**
+     * @brief Reserves room for `n` records in every column.
+     * @param n The number of records expected.
+     */
+    void reserve(std::size_t n) {
+        reserveFields(n, sequence{});
+    }
+
+    /**
+     * @brief Removes every record, keeping the allocated capacity.
+     */
+    void clear() {
+        clearFields(sequence{});
+    }
+
+    /**
+     * @brief Gets the number of records held.
+     * @return The record count.
+     */
+    std::size_t size() const {
+        return std::get<0>(storage).size();
+    }
+
+    /**
+     * @brief Accesses the column of one field.
+     * @tparam Name The field; it must be one of the kept fields.
+     * @return The values of that field, one per record.
+     */
+    template <FixedString Name>
+    const auto& column() const {
+        constexpr std::size_t k = position<Name>();
+        static_assert(k < kept.size(), "field is not part of this projection");
+        return std::get<k>(storage);
+    }
+
+    /**
+     * @brief Accesses the column of one field for modification, e.g. to sort it in place.
+     * @tparam Name The field; it must be one of the kept fields.
+     * @return The values of that field, one per record.
+     */
+    template <FixedString Name>
+    auto& column() {
+        constexpr std::size_t k = position<Name>();
+        static_assert(k < kept.size(), "field is not part of this projection");
+        return std::get<k>(storage);
+    }
+};
+
+#endif // SCHEMA_H
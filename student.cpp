@@ -4,31 +4,65 @@
  */
 
 #include <string>
-#include <stdexcept>
+#include <string_view>
+#include <utility>
 #include "student.h"
-#include "inputvalidation.h"
-#include <iostream>
 
 /**
  * @brief Default constructor initializes a Student object with default values.
+ * @param alloc Allocator used for the student's strings.
  *
- * This constructor sets the `name` to an empty string and the `roll` to -1, representing
- * that the student has not been fully initialized.
+ * This constructor sets the `name` and `section` to empty strings and the `roll` to -1,
+ * representing that the student has not been fully initialized. The remaining fields are 0.
  */
-Student::Student() : name(""), roll(-1) {}
+Student::Student(const allocator_type& alloc)
+    : name(alloc), roll(-1), section(alloc), grade(0), attendance(0), enrolled{0, 0, 0} {}
 
 /**
  * @brief Parameterized constructor initializes a Student object with given values.
  * @param n The student's name.
  * @param r The student's roll number.
+ * @param alloc Allocator used for the student's strings.
  *
- * This constructor initializes the `name` and `roll` member variables using the provided
- * values by calling the `setName` and `setRoll` methods to ensure proper validation.
+ * The name is constructed in place from the view, so the only allocation (if any) is the
+ * one made by `alloc`. Input is assumed to have been validated by checkInput.
  */
-Student::Student(std::string n, int r) {
-    setName(n);
-    setRoll(r);
-}
+Student::Student(std::string_view n, int r, const allocator_type& alloc)
+    : name(n, alloc), roll(r), section(alloc), grade(0), attendance(0), enrolled{0, 0, 0} {}
+
+/**
+ * @brief Parameterized constructor for a name given as a string literal.
+ * @param n The student's name, null-terminated.
+ * @param r The student's roll number.
+ * @param alloc Allocator used for the student's strings.
+ */
+Student::Student(const char* n, int r, const allocator_type& alloc) : Student(std::string_view(n), r, alloc) {}
+
+/**
+ * @brief Parameterized constructor that takes ownership of an existing name.
+ * @param n The student's name, moved into the Student.
+ * @param r The student's roll number.
+ */
+Student::Student(std::pmr::string&& n, int r)
+    : name(std::move(n)), roll(r), section(name.get_allocator()), grade(0), attendance(0), enrolled{0, 0, 0} {}
+
+/**
+ * @brief Allocator-extended copy constructor used by pmr containers.
+ * @param other The Student to copy.
+ * @param alloc Allocator used for the copied strings.
+ */
+Student::Student(const Student& other, const allocator_type& alloc)
+    : name(other.name, alloc), roll(other.roll), section(other.section, alloc),
+      grade(other.grade), attendance(other.attendance), enrolled(other.enrolled) {}
+
+/**
+ * @brief Allocator-extended move constructor used by pmr containers.
+ * @param other The Student to move from.
+ * @param alloc Allocator used for the strings.
+ */
+Student::Student(Student&& other, const allocator_type& alloc)
+    : name(std::move(other.name), alloc), roll(other.roll), section(std::move(other.section), alloc),
+      grade(other.grade), attendance(other.attendance), enrolled(other.enrolled) {}
 
 /**
  * @brief Destructor for the Student class.
@@ -44,8 +78,24 @@ Student::~Student() {}
  * This method updates the `name` member variable with the provided value. It does not
  * perform validation as it assumes the input has already been validated.
  */
-void Student::setName(std::string n) {
-    name = n;
+void Student::setName(std::string_view n) {
+    name.assign(n.data(), n.size());
+}
+
+/**
+ * @brief Sets the student's name from a string literal.
+ * @param n The new name, null-terminated.
+ */
+void Student::setName(const char* n) {
+    setName(std::string_view(n));
+}
+
+/**
+ * @brief Sets the student's name by taking ownership of the provided string.
+ * @param n The new name to set for the student.
+ */
+void Student::setName(std::pmr::string&& n) {
+    name = std::move(n);
 }
 
 /**
@@ -61,11 +111,11 @@ void Student::setRoll(int r) {
 
 /**
  * @brief Gets the student's name.
- * @return The student's name.
+ * @return A view of the student's name.
  *
- * This method returns the current value of the `name` member variable.
+ * No copy is made; the view refers to the Student's own storage.
  */
-std::string Student::getName() const {
+std::string_view Student::getName() const {
     return name;
 }
 
@@ -79,3 +129,74 @@ int Student::getRoll() const {
     return roll;
 }
 
+/**
+ * @brief Sets the student's section.
+ * @param s The new section.
+ */
+void Student::setSection(std::string_view s) {
+    section.assign(s.data(), s.size());
+}
+
+/**
+ * @brief Gets the student's section.
+ * @return A view of the student's section.
+ */
+std::string_view Student::getSection() const {
+    return section;
+}
+
+/**
+ * @brief Sets the student's grade point average.
+ * @param g The new grade.
+ */
+void Student::setGrade(float g) {
+    grade = g;
+}
+
+/**
+ * @brief Gets the student's grade point average.
+ * @return The student's grade.
+ */
+float Student::getGrade() const {
+    return grade;
+}
+
+/**
+ * @brief Sets the student's attendance.
+ * @param a The new attendance, in percent.
+ */
+void Student::setAttendance(int a) {
+    attendance = a;
+}
+
+/**
+ * @brief Gets the student's attendance.
+ * @return The student's attendance, in percent.
+ */
+int Student::getAttendance() const {
+    return attendance;
+}
+
+/**
+ * @brief Sets the student's enrollment date.
+ * @param d The new enrollment date.
+ */
+void Student::setEnrolled(const Date& d) {
+    enrolled = d;
+}
+
+/**
+ * @brief Gets the student's enrollment date.
+ * @return The student's enrollment date.
+ */
+Date Student::getEnrolled() const {
+    return enrolled;
+}
+
+/**
+ * @brief Gets the allocator used for the student's strings.
+ * @return The allocator the name and section were constructed with.
+ */
+Student::allocator_type Student::get_allocator() const {
+    return name.get_allocator();
+}
@@ -6,35 +6,124 @@
 #ifndef STUDENT_H
 #define STUDENT_H
 
+#include <memory_resource>
 #include <string>
+#include <string_view>
+
+/**
+ * @struct Date
+ * @brief A calendar date; all fields are 0 when the date is unknown.
+ */
+struct Date {
+    int year; /**< The year, e.g. 2024. */
+    int month; /**< The month, 1 to 12. */
+    int day; /**< The day of the month, 1 to 31. */
+
+    bool operator==(const Date& other) const = default;
+};
 
 /**
  * @class Student
- * @brief Represents a student with a name and roll number.
+ * @brief Represents a student with a name, roll number, section, grade, attendance and
+ * enrollment date.
  *
- * This class provides methods to set and get the student's name and roll number.
+ * This class provides methods to set and get each of the student's fields. The layout of
+ * the fields in files is described by StudentSchema. The name and section are stored in
+ * `std::pmr::string`s, so a Student can be placed in an arena (see StudentRecords) and
+ * bulk-loaded records never touch the global heap.
  */
 class Student {
 private:
-    std::string name; /**< The student's name. */
+    std::pmr::string name; /**< The student's name. */
     int roll; /**< The student's roll number. */
+    std::pmr::string section; /**< The student's section; empty when not assigned. */
+    float grade; /**< The student's grade point average, 0.0 to 4.0. */
+    int attendance; /**< The student's attendance, in percent. */
+    Date enrolled; /**< The date the student enrolled; all zero when unknown. */
+
+    friend struct StudentFields;
 
 public:
+    /**
+     * @brief Allocator used for the student's strings; makes Student allocator-aware.
+     *
+     * Containers such as `std::pmr::vector<Student>` pass their allocator to every
+     * element they construct, so the name and section land in the same memory resource.
+     */
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
     /**
      * @brief Default constructor initializes a Student object with default values.
+     * @param alloc Allocator used for the student's strings.
      *
-     * This constructor sets the `name` to an empty string and the `roll` to 0.
+     * This constructor sets the `name` and `section` to empty strings, the `roll` to -1 and
+     * the remaining fields to 0.
      */
-    Student();
+    explicit Student(const allocator_type& alloc = {});
 
     /**
      * @brief Parameterized constructor initializes a Student object with given values.
      * @param n The student's name.
      * @param r The student's roll number.
+     * @param alloc Allocator used for the student's strings.
      *
-     * This constructor initializes the `name` and `roll` member variables with the provided values.
+     * This constructor copies the name directly into storage obtained from `alloc`;
+     * no intermediate string is created. The remaining fields start out empty or 0.
+     */
+    Student(std::string_view n, int r, const allocator_type& alloc = {});
+
+    /**
+     * @brief Parameterized constructor for a name given as a string literal.
+     * @param n The student's name, null-terminated.
+     * @param r The student's roll number.
+     * @param alloc Allocator used for the student's strings.
+     *
+     * Without this overload `Student("...", r)` would be ambiguous between the
+     * `std::string_view` and the `std::pmr::string&&` constructors.
+     */
+    Student(const char* n, int r, const allocator_type& alloc = {});
+
+    /**
+     * @brief Parameterized constructor that takes ownership of an existing name.
+     * @param n The student's name, moved into the Student.
+     * @param r The student's roll number.
+     */
+    Student(std::pmr::string&& n, int r);
+
+    /**
+     * @brief Copy constructor.
+     */
+    Student(const Student& other) = default;
+
+    /**
+     * @brief Allocator-extended copy constructor used by pmr containers.
+     * @param other The Student to copy.
+     * @param alloc Allocator used for the copied strings.
+     */
+    Student(const Student& other, const allocator_type& alloc);
+
+    /**
+     * @brief Move constructor.
+     */
+    Student(Student&& other) noexcept = default;
+
+    /**
+     * @brief Allocator-extended move constructor used by pmr containers.
+     * @param other The Student to move from.
+     * @param alloc Allocator used for the strings; the move only steals their buffers
+     * when `alloc` matches the allocator of `other`.
+     */
+    Student(Student&& other, const allocator_type& alloc);
+
+    /**
+     * @brief Copy assignment operator.
+     */
+    Student& operator=(const Student& other) = default;
+
+    /**
+     * @brief Move assignment operator.
      */
-    Student(std::string n, int r);
+    Student& operator=(Student&& other) = default;
 
     /**
      * @brief Destructor for the Student class.
@@ -47,9 +136,25 @@ public:
      * @brief Sets the student's name.
      * @param n The new name to set for the student.
      *
-     * This method updates the `name` member variable with the provided value.
+     * This method copies the provided value into the existing name storage, reusing its
+     * capacity where possible.
      */
-    void setName(std::string n);
+    void setName(std::string_view n);
+
+    /**
+     * @brief Sets the student's name from a string literal.
+     * @param n The new name, null-terminated.
+     *
+     * Resolves the ambiguity between the `std::string_view` and `std::pmr::string&&` overloads
+     * for `setName("...")`.
+     */
+    void setName(const char* n);
+
+    /**
+     * @brief Sets the student's name by taking ownership of the provided string.
+     * @param n The new name to set for the student.
+     */
+    void setName(std::pmr::string&& n);
 
     /**
      * @brief Sets the student's roll number.
@@ -61,11 +166,10 @@ public:
 
     /**
      * @brief Gets the student's name.
-     * @return The student's name.
-     *
-     * This method returns the current value of the `name` member variable.
+     * @return A view of the student's name, valid until the name is modified or the
+     * Student is destroyed.
      */
-    std::string getName() const;
+    std::string_view getName() const;
 
     /**
      * @brief Gets the student's roll number.
@@ -74,7 +178,60 @@ public:
      * This method returns the current value of the `roll` member variable.
      */
     int getRoll() const;
+
+    /**
+     * @brief Sets the student's section.
+     * @param s The new section; empty when not assigned.
+     */
+    void setSection(std::string_view s);
+
+    /**
+     * @brief Gets the student's section.
+     * @return A view of the student's section.
+     */
+    std::string_view getSection() const;
+
+    /**
+     * @brief Sets the student's grade point average.
+     * @param g The new grade, 0.0 to 4.0.
+     */
+    void setGrade(float g);
+
+    /**
+     * @brief Gets the student's grade point average.
+     * @return The student's grade.
+     */
+    float getGrade() const;
+
+    /**
+     * @brief Sets the student's attendance.
+     * @param a The new attendance, in percent.
+     */
+    void setAttendance(int a);
+
+    /**
+     * @brief Gets the student's attendance.
+     * @return The student's attendance, in percent.
+     */
+    int getAttendance() const;
+
+    /**
+     * @brief Sets the student's enrollment date.
+     * @param d The new enrollment date.
+     */
+    void setEnrolled(const Date& d);
+
+    /**
+     * @brief Gets the student's enrollment date.
+     * @return The student's enrollment date.
+     */
+    Date getEnrolled() const;
+
+    /**
+     * @brief Gets the allocator used for the student's strings.
+     * @return The allocator the name and section were constructed with.
+     */
+    allocator_type get_allocator() const;
 };
 
 #endif // STUDENT_H
-
@@ -0,0 +1,141 @@
+/**
+ * @file StudentRecords.cpp
+ * @brief Implements the StudentRecords and AllocationCounter classes.
+ */
+
+#include "studentrecords.h"
+#include "studentschema.h"
+#include <string_view>
+
+using namespace std;
+
+/**
+ * @brief Constructs a counter on top of the given upstream resource.
+ * @param up The resource to forward requests to.
+ */
+AllocationCounter::AllocationCounter(pmr::memory_resource* up) : upstream(up), count(0), total(0) {}
+
+/**
+ * @brief Gets the number of allocations forwarded upstream so far.
+ * @return The allocation count.
+ */
+size_t AllocationCounter::allocations() const {
+    return count;
+}
+
+/**
+ * @brief Gets the number of bytes requested from upstream so far.
+ * @return The byte count.
+ */
+size_t AllocationCounter::bytes() const {
+    return total;
+}
+
+void* AllocationCounter::do_allocate(size_t bytes, size_t alignment) {
+    ++count;
+    total += bytes;
+    return upstream->allocate(bytes, alignment);
+}
+
+void AllocationCounter::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    upstream->deallocate(p, bytes, alignment);
+}
+
+bool AllocationCounter::do_is_equal(const pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+/**
+ * @brief Default constructor creates an empty set of records.
+ *
+ * The arena is set up on top of the counting resource; no memory is requested until the
+ * first record is added.
+ */
+StudentRecords::StudentRecords() : upstream(), arena(chunkSize, &upstream), students(&arena) {}
+
+/**
+ * @brief Reserves space for at least `n` records.
+ * @param n The number of records expected.
+ *
+ * Growing a vector inside a monotonic arena leaves the old buffer behind, so callers that
+ * know the final size should reserve it before adding records.
+ */
+void StudentRecords::reserve(size_t n) {
+    students.reserve(n);
+}
+
+/**
+ * @brief Appends a copy of a record, with its strings in the arena.
+ * @param student The record to copy.
+ * @return The newly added Student.
+ */
+Student& StudentRecords::add(const Student& student) {
+    return students.emplace_back(student);
+}
+
+/**
+ * @brief Parses one line of the student file and appends the record if it is valid.
+ * @param line The line to parse.
+ * @return true if a record was appended, false if the line was malformed.
+ *
+ * A malformed line leaves its partly parsed record behind in the arena; the bytes are only
+ * reclaimed with the arena itself, which is acceptable since such lines are rare.
+ */
+bool StudentRecords::addLine(string_view line) {
+    Student& student = students.emplace_back();
+
+    if (!StudentSchema::parse(line, student)) {
+        students.pop_back();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the number of records held.
+ * @return The record count.
+ */
+size_t StudentRecords::size() const {
+    return students.size();
+}
+
+/**
+ * @brief Checks whether there are no records.
+ * @return true if empty.
+ */
+bool StudentRecords::empty() const {
+    return students.empty();
+}
+
+/**
+ * @brief Accesses a record by position.
+ * @param i The position of the record.
+ * @return The Student at that position.
+ */
+const Student& StudentRecords::operator[](size_t i) const {
+    return students[i];
+}
+
+StudentRecords::const_iterator StudentRecords::begin() const {
+    return students.begin();
+}
+
+StudentRecords::const_iterator StudentRecords::end() const {
+    return students.end();
+}
+
+/**
+ * @brief Gets the number of heap allocations made by the arena so far.
+ * @return The allocation count.
+ */
+size_t StudentRecords::allocationCount() const {
+    return upstream.allocations();
+}
+
+/**
+ * @brief Gets the number of bytes the arena has taken from the heap so far.
+ * @return The byte count.
+ */
+size_t StudentRecords::allocatedBytes() const {
+    return upstream.bytes();
+}
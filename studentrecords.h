@@ -0,0 +1,142 @@
+/**
+ * @file StudentRecords.h
+ * @brief Defines the StudentRecords class, an arena-backed collection of bulk-loaded students.
+ */
+
+#ifndef STUDENTRECORDS_H
+#define STUDENTRECORDS_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+#include "student.h"
+
+/**
+ * @class AllocationCounter
+ * @brief A memory resource that forwards to an upstream resource and counts the requests.
+ *
+ * Placed underneath an arena, it reports how many times the arena had to go back to the
+ * global heap, which makes the allocation cost of a load directly measurable.
+ */
+class AllocationCounter : public std::pmr::memory_resource {
+private:
+    std::pmr::memory_resource* upstream; /**< The resource that actually provides memory. */
+    std::size_t count; /**< Number of allocations forwarded upstream. */
+    std::size_t total; /**< Number of bytes requested from upstream. */
+
+public:
+    /**
+     * @brief Constructs a counter on top of the given upstream resource.
+     * @param up The resource to forward requests to; defaults to the global heap.
+     */
+    explicit AllocationCounter(std::pmr::memory_resource* up = std::pmr::new_delete_resource());
+
+    /**
+     * @brief Gets the number of allocations forwarded upstream so far.
+     * @return The allocation count.
+     */
+    std::size_t allocations() const;
+
+    /**
+     * @brief Gets the number of bytes requested from upstream so far.
+     * @return The byte count.
+     */
+    std::size_t bytes() const;
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+/**
+ * @class StudentRecords
+ * @brief Holds a set of Student records whose names live in a monotonic arena.
+ *
+ * Records are only ever appended, so all memory is carved out of large chunks that are
+ * released together when the StudentRecords object is destroyed. StudentStore::load() parses
+ * each line of the student file straight into a page with addLine(), so loading a file costs
+ * a handful of heap allocations per page rather than one or more per student.
+ */
+class StudentRecords {
+private:
+    AllocationCounter upstream; /**< Counts the chunks the arena takes from the heap. */
+    std::pmr::monotonic_buffer_resource arena; /**< Backing storage for the vector and the names. */
+    std::pmr::vector<Student> students; /**< The records, in file order. */
+
+public:
+    /**
+     * @brief Size of the first chunk requested by the arena; later chunks grow geometrically.
+     */
+    static constexpr std::size_t chunkSize = 64 * 1024;
+
+    using const_iterator = std::pmr::vector<Student>::const_iterator;
+
+    /**
+     * @brief Default constructor creates an empty set of records.
+     */
+    StudentRecords();
+
+    StudentRecords(const StudentRecords&) = delete;
+    StudentRecords& operator=(const StudentRecords&) = delete;
+
+    /**
+     * @brief Reserves space for at least `n` records.
+     * @param n The number of records expected.
+     */
+    void reserve(std::size_t n);
+
+    /**
+     * @brief Appends a copy of a record, with its strings in the arena.
+     * @param student The record to copy.
+     * @return The newly added Student.
+     */
+    Student& add(const Student& student);
+
+    /**
+     * @brief Parses one line of the student file and appends the record if it is valid.
+     * @param line The line, in the form written by StudentSchema::format().
+     * @return true if a record was appended, false if the line was malformed.
+     *
+     * The line is parsed straight into the new record, so its strings are copied once,
+     * directly into the arena.
+     */
+    bool addLine(std::string_view line);
+
+    /**
+     * @brief Gets the number of records held.
+     * @return The record count.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Checks whether there are no records.
+     * @return true if empty.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Accesses a record by position.
+     * @param i The position of the record.
+     * @return The Student at that position.
+     */
+    const Student& operator[](std::size_t i) const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /**
+     * @brief Gets the number of heap allocations made by the arena so far.
+     * @return The allocation count.
+     */
+    std::size_t allocationCount() const;
+
+    /**
+     * @brief Gets the number of bytes the arena has taken from the heap so far.
+     * @return The byte count.
+     */
+    std::size_t allocatedBytes() const;
+};
+
+#endif // STUDENTRECORDS_H
@@ -0,0 +1,85 @@
+/**
+ * @file StudentSchema.h
+ * @brief Defines StudentSchema, the field layout of a Student record.
+ */
+
+#ifndef STUDENTSCHEMA_H
+#define STUDENTSCHEMA_H
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include "schema.h"
+#include "student.h"
+#include "inputvalidation.h"
+
+/**
+ * @brief Dates are written as YYYY-MM-DD and packed as a single YYYYMMDD integer.
+ */
+template <>
+struct FieldCodec<Date> {
+    using column_type = Date;
+    static constexpr std::size_t packedSize = sizeof(std::int32_t);
+
+    static bool parse(std::string_view text, Date& value) {
+        if (text.size() != 10 || text[4] != '-' || text[7] != '-') {
+            return false;
+        }
+
+        const char* p = text.data();
+        return std::from_chars(p, p + 4, value.year).ptr == p + 4 &&
+               std::from_chars(p + 5, p + 7, value.month).ptr == p + 7 &&
+               std::from_chars(p + 8, p + 10, value.day).ptr == p + 10;
+    }
+
+    static void format(std::ostream& out, const Date& value) {
+        char text[16];
+        std::snprintf(text, sizeof text, "%04d-%02d-%02d", value.year, value.month, value.day);
+        out << text;
+    }
+
+    static void pack(char* out, const Date& value, std::string&) {
+        std::int32_t v = value.year * 10000 + value.month * 100 + value.day;
+        std::memcpy(out, &v, sizeof v);
+    }
+
+    static bool unpack(const char* in, std::string_view, Date& value) {
+        std::int32_t v;
+        std::memcpy(&v, in, sizeof v);
+        value = {v / 10000, v / 100 % 100, v % 100};
+        return true;
+    }
+
+    static Date toColumn(const Date& value) {
+        return value;
+    }
+};
+
+/**
+ * @struct StudentFields
+ * @brief Binds the schema fields to the private members of Student.
+ *
+ * The order of the fields is the order of the words in a line of the student file. Name and
+ * roll number come first so that files written before the other fields existed still parse.
+ * To add a field, add the member to Student and one line here.
+ */
+struct StudentFields {
+    using schema = Schema<Student,
+                          Field<"name", &Student::name, fieldText, &checkInput::checkName>,
+                          Field<"roll", &Student::roll, 0, &checkInput::checkRoll>,
+                          Field<"section", &Student::section, fieldOptional, &checkInput::checkSection>,
+                          Field<"grade", &Student::grade, fieldOptional, &checkInput::checkGrade>,
+                          Field<"attendance", &Student::attendance, fieldOptional, &checkInput::checkAttendance>,
+                          Field<"enrolled", &Student::enrolled, fieldOptional, &checkInput::checkDate>>;
+};
+
+/**
+ * @brief The schema of a Student record: serializer, parser, validator and column layout.
+ */
+using StudentSchema = StudentFields::schema;
+
+#endif // STUDENTSCHEMA_H
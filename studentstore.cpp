@@ -0,0 +1,501 @@
+/**
+ * @file StudentStore.cpp
+ * @brief Implements the StudentStore class and its snapshots.
+ */
+
+#include "studentstore.h"
+#include "filehandling.h"
+#include "studentschema.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Creates an empty page with room for a full page of students.
+ * @return The new page.
+ */
+shared_ptr<StudentRecords> newPage() {
+    auto page = make_shared<StudentRecords>();
+    page->reserve(StudentStore::pageSize);
+    return page;
+}
+
+} // namespace
+
+/**
+ * @brief Creates a snapshot owning the given hazard slot.
+ * @param s The slot pinning `v`.
+ * @param v The pinned version.
+ */
+StudentStore::Snapshot::Snapshot(Slot* s, const Version* v) : slot(s), version(v) {}
+
+StudentStore::Snapshot::Snapshot(Snapshot&& other) noexcept : slot(other.slot), version(other.version) {
+    other.slot = nullptr;
+    other.version = nullptr;
+}
+
+StudentStore::Snapshot& StudentStore::Snapshot::operator=(Snapshot&& other) noexcept {
+    swap(slot, other.slot);
+    swap(version, other.version);
+    return *this;
+}
+
+/**
+ * @brief Releases the pinned version.
+ *
+ * Clearing the hazard pointer lets the next writer reclaim the version if it has been
+ * replaced in the meantime; the slot is then handed back for other snapshots.
+ */
+StudentStore::Snapshot::~Snapshot() {
+    if (slot) {
+        slot->hazard.store(nullptr, memory_order_release);
+        slot->used.store(false, memory_order_release);
+        slot = nullptr;
+    }
+}
+
+/**
+ * @brief Gets the number of students in this view.
+ * @return The student count.
+ */
+size_t StudentStore::Snapshot::size() const {
+    return version->size;
+}
+
+/**
+ * @brief Gets the version number of this view.
+ * @return The number of writes published before this view was taken.
+ */
+uint64_t StudentStore::Snapshot::number() const {
+    return version->number;
+}
+
+/**
+ * @brief Gets the number of pages in this view.
+ * @return The page count.
+ */
+size_t StudentStore::Snapshot::pageCount() const {
+    return version->pages.size();
+}
+
+/**
+ * @brief Accesses one page of this view.
+ * @param i The position of the page.
+ * @return The students on that page.
+ */
+const StudentRecords& StudentStore::Snapshot::page(size_t i) const {
+    return *version->pages[i];
+}
+
+/**
+ * @brief Gets the number of heap allocations made by the arenas of this view's pages.
+ * @return The sum of StudentRecords::allocationCount() over every page.
+ *
+ * Published pages are never modified, so their counters can be read without locking.
+ */
+size_t StudentStore::Snapshot::allocationCount() const {
+    size_t total = 0;
+    for (const auto& p : version->pages) {
+        total += p->allocationCount();
+    }
+    return total;
+}
+
+/**
+ * @brief Gets the number of bytes the arenas of this view's pages took from the heap.
+ * @return The sum of StudentRecords::allocatedBytes() over every page.
+ */
+size_t StudentStore::Snapshot::allocatedBytes() const {
+    size_t total = 0;
+    for (const auto& p : version->pages) {
+        total += p->allocatedBytes();
+    }
+    return total;
+}
+
+/**
+ * @brief Finds the first student with the given roll number.
+ * @param roll The roll number to look for.
+ * @return The student, or nullptr if there is none.
+ */
+const Student* StudentStore::Snapshot::find(int roll) const {
+    for (const auto& p : version->pages) {
+        for (const Student& student : *p) {
+            if (student.getRoll() == roll) {
+                return &student;
+            }
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Default constructor creates an empty store.
+ *
+ * The store starts with an empty version 0 so that readers always find a published version.
+ */
+StudentStore::StudentStore() : current(new Version{{}, 0, 0, nullptr}) {}
+
+/**
+ * @brief Destroys the store and every version it still holds.
+ */
+StudentStore::~StudentStore() {
+    delete current.load();
+    for (const Version* version : retired) {
+        delete version;
+    }
+}
+
+/**
+ * @brief Takes a snapshot of the current version.
+ * @return A view that stays consistent regardless of later writes.
+ *
+ * The reader claims a free hazard slot, starting the search at a position derived from its
+ * thread id to keep concurrent readers apart, then publishes the version it is about to read
+ * and checks that it is still current. Once the check passes, no writer will free it.
+ */
+StudentStore::Snapshot StudentStore::snapshot() const {
+    size_t start = hash<thread::id>{}(this_thread::get_id()) % maxReaders;
+
+    for (;;) {
+        for (size_t i = 0; i < maxReaders; ++i) {
+            Slot& slot = slots[(start + i) % maxReaders];
+            bool expected = false;
+
+            if (slot.used.load(memory_order_relaxed) ||
+                !slot.used.compare_exchange_strong(expected, true, memory_order_acquire)) {
+                continue;
+            }
+
+            const Version* version = current.load();
+            for (;;) {
+                slot.hazard.store(version);
+                const Version* again = current.load();
+                if (again == version) {
+                    break;
+                }
+                version = again;
+            }
+            return Snapshot(&slot, version);
+        }
+        this_thread::yield();
+    }
+}
+
+/**
+ * @brief Replaces the contents of the store with the records of a student file.
+ * @param filename The file to read.
+ * @return true if the file could be opened, false otherwise.
+ *
+ * The file is parsed straight into fresh pages, which are published as a single new version.
+ * Non-blank lines that are not valid records are kept verbatim in the version, so that
+ * save() can write them back.
+ */
+bool StudentStore::load(const string& filename) {
+    FileHandling file(filename);
+    string contents;
+    FileStamp loaded = stampOf(filename);
+
+    if (!file.readContents(contents)) {
+        return false;
+    }
+
+    auto next = make_unique<Version>();
+    next->size = 0;
+    auto unparsed = make_shared<vector<string>>();
+    shared_ptr<StudentRecords> page;
+    string_view rest(contents);
+
+    while (!rest.empty()) {
+        size_t end = rest.find('\n');
+        string_view line = rest.substr(0, end);
+        rest.remove_prefix(end == string_view::npos ? rest.size() : end + 1);
+
+        if (!page || page->size() == pageSize) {
+            page = newPage();
+        }
+        if (page->addLine(line)) {
+            // A page joins the version with its first record, so no page is ever empty.
+            if (page->size() == 1) {
+                next->pages.push_back(page);
+            }
+            ++next->size;
+        } else if (line.find_first_not_of(" \t\r") != string_view::npos) {
+            unparsed->emplace_back(line);
+        }
+    }
+
+    if (!unparsed->empty()) {
+        next->unparsed = move(unparsed);
+    }
+
+    lock_guard<mutex> lock(writer);
+    next->number = current.load()->number + 1;
+    publish(next.release());
+    source = filename;
+    stamp = loaded;
+    return true;
+}
+
+/**
+ * @brief Reloads the store if a student file changed since the store last read or wrote it.
+ * @param filename The file to check.
+ * @return true if the store was reloaded, false if it already reflects the file.
+ *
+ * The file is compared by modification time and size. The stamp is taken before the file
+ * is read, so a change that races with the read only causes one more reload later.
+ */
+bool StudentStore::refresh(const string& filename) {
+    FileStamp now = stampOf(filename);
+    {
+        lock_guard<mutex> lock(writer);
+        if (source == filename && stamp == now) {
+            return false;
+        }
+    }
+
+    if (now.exists) {
+        return load(filename);
+    }
+
+    lock_guard<mutex> lock(writer);
+    publish(new Version{{}, 0, current.load()->number + 1, nullptr});
+    source = filename;
+    stamp = FileStamp{};
+    return true;
+}
+
+/**
+ * @brief Writes the current version to a student file.
+ * @param filename The file to write.
+ * @return true if the file was written, false otherwise.
+ *
+ * The records come from a snapshot, so writers are free to continue while the file is
+ * being written.
+ */
+bool StudentStore::save(const string& filename) {
+    Snapshot view = snapshot();
+    string temp = filename + ".tmp";
+
+    ofstream out(temp, ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    view.forEach([&](const Student& student) {
+        StudentSchema::format(out, student);
+        out << '\n';
+    });
+    if (view.version->unparsed) {
+        for (const string& line : *view.version->unparsed) {
+            out << line << '\n';
+        }
+    }
+    out.close();
+
+    if (!out || std::rename(temp.c_str(), filename.c_str()) != 0) {
+        std::remove(temp.c_str());
+        return false;
+    }
+
+    lock_guard<mutex> lock(writer);
+    source = filename;
+    stamp = stampOf(filename);
+    return true;
+}
+
+/**
+ * @brief Appends a student.
+ * @param student The student to add.
+ *
+ * Only the last page is copied; a new page is started when it is full.
+ */
+void StudentStore::add(const Student& student) {
+    lock_guard<mutex> lock(writer);
+    const Version* old = current.load();
+    auto next = make_unique<Version>(*old);
+
+    auto page = newPage();
+    if (!next->pages.empty() && next->pages.back()->size() < pageSize) {
+        for (const Student& existing : *next->pages.back()) {
+            page->add(existing);
+        }
+        next->pages.pop_back();
+    }
+    page->add(student);
+    next->pages.push_back(page);
+
+    ++next->size;
+    ++next->number;
+    publish(next.release());
+}
+
+/**
+ * @brief Appends a student to the store and to a student file.
+ * @param student The student to add.
+ * @param filename The file to append the record to.
+ *
+ * The file is stamped again afterwards, so the store's own append does not trigger a reload.
+ */
+void StudentStore::append(const Student& student, const string& filename) {
+    add(student);
+    FileHandling file(filename);
+    file.appendStudent(student);
+
+    lock_guard<mutex> lock(writer);
+    source = filename;
+    stamp = stampOf(filename);
+}
+
+/**
+ * @brief Renames every student with the given roll number.
+ * @param roll The roll number to look for.
+ * @param name The new name.
+ * @return The number of students renamed.
+ *
+ * Only pages holding the roll number are copied. Nothing is published if no student matches.
+ */
+size_t StudentStore::rename(int roll, string_view name) {
+    lock_guard<mutex> lock(writer);
+    const Version* old = current.load();
+    auto next = make_unique<Version>(*old);
+    size_t renamed = 0;
+
+    for (size_t i = 0; i < old->pages.size(); ++i) {
+        const StudentRecords& source = *old->pages[i];
+        bool touched = false;
+        for (const Student& student : source) {
+            touched = touched || student.getRoll() == roll;
+        }
+        if (!touched) {
+            continue;
+        }
+
+        auto page = newPage();
+        for (const Student& student : source) {
+            Student& copy = page->add(student);
+            if (copy.getRoll() == roll) {
+                copy.setName(name);
+                ++renamed;
+            }
+        }
+        next->pages[i] = page;
+    }
+
+    if (renamed > 0) {
+        ++next->number;
+        publish(next.release());
+    }
+    return renamed;
+}
+
+/**
+ * @brief Removes every student matching a predicate.
+ * @param pred Returns true for the students to remove.
+ * @return Copies of the removed students, in order.
+ *
+ * Pages without a match are shared with the new version as they are; pages that become
+ * empty are dropped. Nothing is published if no student matches.
+ */
+vector<Student> StudentStore::removeIf(const function<bool(const Student&)>& pred) {
+    lock_guard<mutex> lock(writer);
+    const Version* old = current.load();
+    auto next = make_unique<Version>(Version{{}, old->size, old->number + 1, old->unparsed});
+    vector<Student> removed;
+
+    for (const auto& source : old->pages) {
+        size_t before = removed.size();
+        shared_ptr<StudentRecords> page;
+
+        for (size_t i = 0; i < source->size(); ++i) {
+            const Student& student = (*source)[i];
+            if (pred(student)) {
+                if (!page) {
+                    page = newPage();
+                    for (size_t j = 0; j < i; ++j) {
+                        page->add((*source)[j]);
+                    }
+                }
+                removed.push_back(student);
+            } else if (page) {
+                page->add(student);
+            }
+        }
+
+        if (removed.size() == before) {
+            next->pages.push_back(source);
+        } else if (!page->empty()) {
+            next->pages.push_back(page);
+        }
+    }
+
+    if (!removed.empty()) {
+        next->size -= removed.size();
+        publish(next.release());
+    }
+    return removed;
+}
+
+/**
+ * @brief Reads the modification time and size of a file.
+ * @param filename The file.
+ * @return Its stamp; `exists` is false if the file cannot be inspected.
+ */
+StudentStore::FileStamp StudentStore::stampOf(const string& filename) {
+    error_code error;
+    FileStamp result;
+    result.time = filesystem::last_write_time(filename, error);
+    if (error) {
+        return FileStamp{};
+    }
+    result.size = filesystem::file_size(filename, error);
+    result.exists = !error;
+    return result;
+}
+
+/**
+ * @brief Publishes a new version and retires the one it replaces.
+ * @param next The new version; ownership passes to the store.
+ *
+ * Must be called with `writer` held.
+ */
+void StudentStore::publish(Version* next) {
+    retired.push_back(current.exchange(next));
+    reclaim();
+}
+
+/**
+ * @brief Frees every retired version that no snapshot has pinned.
+ *
+ * Must be called with `writer` held.
+ */
+void StudentStore::reclaim() {
+    vector<const Version*> pinned;
+    for (const Slot& slot : slots) {
+        if (const Version* version = slot.hazard.load()) {
+            pinned.push_back(version);
+        }
+    }
+
+    size_t kept = 0;
+    for (const Version* version : retired) {
+        if (find(pinned.begin(), pinned.end(), version) != pinned.end()) {
+            retired[kept++] = version;
+        } else {
+            delete version;
+        }
+    }
+    retired.resize(kept);
+}
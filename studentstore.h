@@ -0,0 +1,265 @@
+/**
+ * @file StudentStore.h
+ * @brief Defines the StudentStore class, a versioned in-memory student set with snapshot reads.
+ */
+
+#ifndef STUDENTSTORE_H
+#define STUDENTSTORE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "student.h"
+#include "studentrecords.h"
+
+/**
+ * @class StudentStore
+ * @brief Holds the student set as a sequence of immutable versions.
+ *
+ * Each version is a table of pages, and each page is a StudentRecords arena of at most
+ * `pageSize` students. A write copies only the pages it touches, builds a new page table
+ * that shares every other page with the previous version, and publishes it with a single
+ * atomic pointer swap. Writers are serialized among themselves but never wait on readers.
+ *
+ * Readers take a Snapshot, which pins the version current at that moment through a hazard
+ * pointer. Pinning is lock-free and a pinned version stays valid, unchanged, for as long as
+ * the Snapshot lives. Versions replaced by a writer are retired and freed by a later write
+ * once no hazard pointer refers to them; pages are shared between versions and freed with
+ * the last version that uses them.
+ */
+class StudentStore {
+private:
+    /**
+     * @struct Version
+     * @brief One immutable state of the student set.
+     */
+    struct Version {
+        std::vector<std::shared_ptr<const StudentRecords>> pages; /**< The page table. */
+        std::size_t size; /**< Total number of students across all pages. */
+        std::uint64_t number; /**< Increases by one with every published write. */
+        std::shared_ptr<const std::vector<std::string>> unparsed; /**< Lines of the loaded file that are not valid records; may be null. */
+    };
+
+    /**
+     * @struct FileStamp
+     * @brief Identifies one state of a file on disk by its modification time and size.
+     */
+    struct FileStamp {
+        bool exists = false; /**< Whether the file existed. */
+        std::filesystem::file_time_type time{}; /**< Last modification time. */
+        std::uintmax_t size = 0; /**< Size in bytes. */
+
+        bool operator==(const FileStamp& other) const = default;
+    };
+
+    /**
+     * @struct Slot
+     * @brief A hazard pointer owned by at most one Snapshot at a time.
+     */
+    struct alignas(64) Slot {
+        std::atomic<bool> used{false}; /**< Whether a Snapshot currently owns this slot. */
+        std::atomic<const Version*> hazard{nullptr}; /**< The version the owner is reading. */
+    };
+
+public:
+    /**
+     * @brief Maximum number of students per page.
+     */
+    static constexpr std::size_t pageSize = 1024;
+
+    /**
+     * @brief Maximum number of snapshots that can be held at the same time.
+     *
+     * Taking a snapshot while all slots are in use waits until one is released.
+     */
+    static constexpr std::size_t maxReaders = 128;
+
+    /**
+     * @class Snapshot
+     * @brief A consistent, point-in-time view of the student set.
+     *
+     * A Snapshot is unaffected by writes made after it was taken and never blocks them.
+     * It must not outlive the StudentStore it came from.
+     */
+    class Snapshot {
+    private:
+        Slot* slot; /**< The hazard pointer pinning `version`. */
+        const Version* version; /**< The pinned version. */
+
+        friend class StudentStore;
+        Snapshot(Slot* s, const Version* v);
+
+    public:
+        Snapshot(Snapshot&& other) noexcept;
+        Snapshot& operator=(Snapshot&& other) noexcept;
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+
+        /**
+         * @brief Releases the pinned version.
+         */
+        ~Snapshot();
+
+        /**
+         * @brief Gets the number of students in this view.
+         * @return The student count.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Gets the version number of this view.
+         * @return The number of writes published before this view was taken.
+         */
+        std::uint64_t number() const;
+
+        /**
+         * @brief Gets the number of pages in this view.
+         * @return The page count.
+         */
+        std::size_t pageCount() const;
+
+        /**
+         * @brief Accesses one page of this view.
+         * @param i The position of the page.
+         * @return The students on that page, in order.
+         */
+        const StudentRecords& page(std::size_t i) const;
+
+        /**
+         * @brief Gets the number of heap allocations made by the arenas of this view's pages.
+         * @return The sum of StudentRecords::allocationCount() over every page.
+         */
+        std::size_t allocationCount() const;
+
+        /**
+         * @brief Gets the number of bytes the arenas of this view's pages took from the heap.
+         * @return The sum of StudentRecords::allocatedBytes() over every page.
+         */
+        std::size_t allocatedBytes() const;
+
+        /**
+         * @brief Finds the first student with the given roll number.
+         * @param roll The roll number to look for.
+         * @return The student, or nullptr if there is none.
+         */
+        const Student* find(int roll) const;
+
+        /**
+         * @brief Calls `f` for every student in this view, in order.
+         * @param f A callable taking `const Student&`.
+         */
+        template <typename F>
+        void forEach(F&& f) const {
+            for (const auto& p : version->pages) {
+                for (const Student& student : *p) {
+                    f(student);
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Default constructor creates an empty store.
+     */
+    StudentStore();
+
+    StudentStore(const StudentStore&) = delete;
+    StudentStore& operator=(const StudentStore&) = delete;
+
+    /**
+     * @brief Destroys the store and every version it still holds.
+     *
+     * No Snapshot of this store may be alive at this point.
+     */
+    ~StudentStore();
+
+    /**
+     * @brief Takes a snapshot of the current version.
+     * @return A view that stays consistent regardless of later writes.
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * @brief Replaces the contents of the store with the records of a student file.
+     * @param filename The file to read.
+     * @return true if the file could be opened, false otherwise (the store is left unchanged).
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * @brief Reloads the store if a student file changed since the store last read or wrote it.
+     * @param filename The file to check.
+     * @return true if the store was reloaded, false if it already reflects the file.
+     *
+     * A missing file counts as an empty one; a file that cannot be read leaves the store as it
+     * is. Callers that go on to write the file should hold a FileLock on it from before this
+     * call until the write is done.
+     */
+    bool refresh(const std::string& filename);
+
+    /**
+     * @brief Writes the current version to a student file.
+     * @param filename The file to write.
+     * @return true if the file was written, false otherwise.
+     *
+     * The records are written to a temporary file that is then renamed over `filename`, so
+     * other processes reading the file see either the old or the new contents in full.
+     * The file is replaced as a whole: call refresh() under a FileLock first so that changes
+     * made by other processes are not lost. Lines of the loaded file that were not valid
+     * records are written back unchanged after the records, so saving never deletes them.
+     */
+    bool save(const std::string& filename);
+
+    /**
+     * @brief Appends a student.
+     * @param student The student to add; it is copied into the store.
+     */
+    void add(const Student& student);
+
+    /**
+     * @brief Appends a student to the store and to a student file.
+     * @param student The student to add.
+     * @param filename The file to append the record to.
+     *
+     * Call refresh() under a FileLock first, as for save().
+     */
+    void append(const Student& student, const std::string& filename);
+
+    /**
+     * @brief Renames every student with the given roll number.
+     * @param roll The roll number to look for.
+     * @param name The new name.
+     * @return The number of students renamed.
+     */
+    std::size_t rename(int roll, std::string_view name);
+
+    /**
+     * @brief Removes every student matching a predicate.
+     * @param pred Returns true for the students to remove.
+     * @return Copies of the removed students, in order.
+     */
+    std::vector<Student> removeIf(const std::function<bool(const Student&)>& pred);
+
+private:
+    std::atomic<const Version*> current; /**< The published version. */
+    mutable std::array<Slot, maxReaders> slots; /**< Hazard pointers of live snapshots. */
+    std::mutex writer; /**< Serializes writers; never taken by readers. */
+    std::vector<const Version*> retired; /**< Replaced versions awaiting reclamation. */
+    std::string source; /**< The file the store last read or wrote; guarded by `writer`. */
+    FileStamp stamp; /**< State of `source` when it was last read or written; guarded by `writer`. */
+
+    static FileStamp stampOf(const std::string& filename);
+
+    void publish(Version* next);
+    void reclaim();
+};
+
+#endif // STUDENTSTORE_H
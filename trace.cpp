@@ -0,0 +1,258 @@
+/**
+ * @file Trace.cpp
+ * @brief Implements the Trace and TraceRecorder classes.
+ */
+
+#include "trace.h"
+#include "filehandling.h"
+#include "studentschema.h"
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief The first 8 bytes of every trace file.
+ */
+constexpr char magic[8] = {'S', 'T', 'M', 'S', 'T', 'R', 'C', '1'};
+
+/**
+ * @brief Appends the bytes of a trivially copyable value to a buffer.
+ * @param buffer The buffer.
+ * @param value The value.
+ */
+template <typename T>
+void put(string& buffer, const T& value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof value);
+}
+
+/**
+ * @brief Reads a trivially copyable value from a buffer.
+ * @param in Points at the value's bytes.
+ * @return The value.
+ */
+template <typename T>
+T get(const char* in) {
+    T value;
+    memcpy(&value, in, sizeof value);
+    return value;
+}
+
+/**
+ * @brief Feeds bytes into a 64-bit FNV-1a hash.
+ * @param hash The hash so far.
+ * @param bytes The bytes to add.
+ * @return The updated hash.
+ */
+uint64_t fnv1a(uint64_t hash, string_view bytes) {
+    for (unsigned char c : bytes) {
+        hash = (hash ^ c) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+} // namespace
+
+/**
+ * @brief Creates an event; `time` and `latency` start at 0.
+ * @param o The operation.
+ * @param r The roll number argument, or -1.
+ * @param res The result of the operation.
+ * @param t The text argument.
+ * @param s The student argument.
+ */
+TraceEvent::TraceEvent(TraceOp o, int32_t r, uint32_t res, string_view t, const Student& s)
+    : op(o), roll(r), result(res), time(0), latency(0), text(t), student(s) {}
+
+/**
+ * @brief Default constructor creates an empty, incomplete trace.
+ */
+Trace::Trace() : started(0), initial(), final(), complete(false) {}
+
+/**
+ * @brief Reads a trace file.
+ * @param filename The file to read.
+ * @return true if the file could be opened and has a valid header, false otherwise.
+ *
+ * The whole file is read into one buffer and decoded in place. Decoding stops at the `end`
+ * event or at the first event that is cut short or malformed.
+ */
+bool Trace::load(const string& filename) {
+    FileHandling file(filename);
+    string contents;
+
+    if (!file.readContents(contents) || contents.size() < headerSize ||
+        memcmp(contents.data(), magic, sizeof magic) != 0) {
+        return false;
+    }
+
+    const char* p = contents.data();
+    started = get<uint64_t>(p + 8);
+    initial = {get<uint64_t>(p + 16), get<uint64_t>(p + 24)};
+    complete = false;
+    events.clear();
+
+    size_t at = headerSize;
+    while (contents.size() - at >= eventSize) {
+        p = contents.data() + at;
+        uint32_t length = get<uint32_t>(p + 12);
+        if (length > contents.size() - at - eventSize) {
+            break;
+        }
+        string_view payload(p + eventSize, length);
+        at += eventSize + length;
+
+        TraceEvent event;
+        event.op = static_cast<TraceOp>(get<uint8_t>(p));
+        event.roll = get<int32_t>(p + 4);
+        event.result = get<uint32_t>(p + 8);
+        event.time = get<uint64_t>(p + 16);
+        event.latency = get<uint64_t>(p + 24);
+
+        if (event.op == TraceOp::end) {
+            if (payload.size() == 2 * sizeof(uint64_t)) {
+                final = {get<uint64_t>(payload.data()), get<uint64_t>(payload.data() + 8)};
+                complete = true;
+            }
+            break;
+        }
+        if (static_cast<size_t>(event.op) >= traceOpCount) {
+            break;
+        }
+
+        if (event.op == TraceOp::add) {
+            if (payload.size() < StudentSchema::packedSize ||
+                !StudentSchema::unpack(payload.data(), payload.substr(StudentSchema::packedSize), event.student)) {
+                break;
+            }
+        } else {
+            event.text.assign(payload);
+        }
+        events.push_back(move(event));
+    }
+
+    return true;
+}
+
+/**
+ * @brief Computes the checksum of one student over all of its fields.
+ * @param student The student.
+ * @return A 64-bit FNV-1a hash of the student's packed form and string heap.
+ *
+ * Hashing the packed form means every field in StudentSchema is covered, including fields
+ * added later, and the result does not depend on how the fields are laid out in memory.
+ */
+uint64_t Trace::checksum(const Student& student) {
+    char row[StudentSchema::packedSize];
+    string heap;
+    StudentSchema::pack(row, student, heap);
+    return fnv1a(fnv1a(0xcbf29ce484222325ULL, string_view(row, sizeof row)), heap);
+}
+
+/**
+ * @brief Computes the state of a snapshot.
+ * @param view The snapshot.
+ * @return Its size and the sum of the checksums of its students.
+ *
+ * The checksums are added, so the result depends only on which students are in the
+ * snapshot and not on their order.
+ */
+TraceState Trace::state(const StudentStore::Snapshot& view) {
+    TraceState state;
+    view.forEach([&state](const Student& student) {
+        ++state.students;
+        state.checksum += checksum(student);
+    });
+    return state;
+}
+
+/**
+ * @brief Creates the trace file and writes its header.
+ * @param filename The file to create; an existing file is overwritten.
+ * @param view The store as it is when recording begins.
+ */
+TraceRecorder::TraceRecorder(const string& filename, const StudentStore::Snapshot& view)
+    : out(filename, ios::out | ios::binary | ios::trunc), origin(chrono::steady_clock::now()) {
+    TraceState initial = Trace::state(view);
+    uint64_t started = static_cast<uint64_t>(
+        chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch()).count());
+
+    buffer.append(magic, sizeof magic);
+    put(buffer, started);
+    put(buffer, initial.students);
+    put(buffer, initial.checksum);
+    out.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+    out.flush();
+}
+
+/**
+ * @brief Checks whether the file could be created and written so far.
+ * @return true if every write succeeded.
+ */
+bool TraceRecorder::good() const {
+    return out.good();
+}
+
+/**
+ * @brief Records an operation that has just finished.
+ * @param event The operation; its `time` and `latency` are filled in from `start`.
+ * @param start When the operation started.
+ *
+ * The clock is read before anything is encoded, so the recorded latency covers only the
+ * operation itself.
+ */
+void TraceRecorder::record(TraceEvent event, chrono::steady_clock::time_point start) {
+    auto now = chrono::steady_clock::now();
+    event.time = static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(start - origin).count());
+    event.latency = static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(now - start).count());
+
+    if (event.op == TraceOp::add) {
+        char row[StudentSchema::packedSize];
+        heap.clear();
+        StudentSchema::pack(row, event.student, heap);
+        heap.insert(0, row, sizeof row);
+        write(event, heap);
+    } else {
+        write(event, event.text);
+    }
+}
+
+/**
+ * @brief Writes the closing `end` event.
+ * @param view The store as it is when recording ends.
+ */
+void TraceRecorder::finish(const StudentStore::Snapshot& view) {
+    TraceState final = Trace::state(view);
+    TraceEvent event;
+    event.time = static_cast<uint64_t>(
+        chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - origin).count());
+
+    string payload;
+    put(payload, final.students);
+    put(payload, final.checksum);
+    write(event, payload);
+}
+
+/**
+ * @brief Encodes one event with its payload and writes it to the file.
+ * @param event The event.
+ * @param payload The payload bytes.
+ */
+void TraceRecorder::write(const TraceEvent& event, string_view payload) {
+    buffer.clear();
+    put(buffer, static_cast<uint8_t>(event.op));
+    buffer.append(3, '\0');
+    put(buffer, event.roll);
+    put(buffer, event.result);
+    put(buffer, static_cast<uint32_t>(payload.size()));
+    put(buffer, event.time);
+    put(buffer, event.latency);
+    buffer.append(payload);
+
+    out.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+    out.flush();
+}
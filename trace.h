@@ -0,0 +1,183 @@
+/**
+ * @file Trace.h
+ * @brief Defines the binary operation trace written by TraceRecorder and read back by Trace.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "student.h"
+#include "studentstore.h"
+
+/**
+ * @brief The kind of a traced operation.
+ *
+ * The values of the menu operations match their menu choices; `end` closes a trace.
+ */
+enum class TraceOp : std::uint8_t {
+    end = 0, /**< End of the trace; carries the final state of the store. */
+    add = 1, /**< A student was added. */
+    view = 2, /**< All records were listed. */
+    search = 3, /**< A student was looked up by roll number. */
+    update = 4, /**< Every student with a roll number was renamed. */
+    remove = 5, /**< Every student whose name contains a pattern was removed. */
+    fuzzy = 6, /**< Names were searched with the fuzzy name index. */
+    statistics = 7 /**< Statistics of the student set were computed. */
+};
+
+/**
+ * @brief Number of TraceOp values.
+ */
+constexpr std::size_t traceOpCount = 8;
+
+/**
+ * @struct TraceState
+ * @brief A fingerprint of the student set: its size and an order-independent checksum.
+ */
+struct TraceState {
+    std::uint64_t students = 0; /**< Number of students. */
+    std::uint64_t checksum = 0; /**< Sum of Trace::checksum() over every student. */
+
+    bool operator==(const TraceState& other) const = default;
+};
+
+/**
+ * @struct TraceEvent
+ * @brief One traced operation.
+ *
+ * Only the arguments used by the operation are meaningful: `student` for add, `roll` for
+ * search and update, `text` for update (the new name), remove (the pattern) and fuzzy (the
+ * query). Remove events may also carry a `roll` that identifies the key they act on.
+ */
+struct TraceEvent {
+    TraceOp op; /**< The operation. */
+    std::int32_t roll; /**< The roll number argument, or -1. */
+    std::uint32_t result; /**< Students found, added, renamed, removed, listed or matched. */
+    std::uint64_t time; /**< Start of the operation, in nanoseconds since the trace began. */
+    std::uint64_t latency; /**< Duration of the operation, in nanoseconds. */
+    std::string text; /**< The text argument. */
+    Student student; /**< The student argument. */
+
+    /**
+     * @brief Creates an event; `time` and `latency` start at 0.
+     * @param o The operation.
+     * @param r The roll number argument, or -1.
+     * @param res The result of the operation.
+     * @param t The text argument.
+     * @param s The student argument.
+     */
+    explicit TraceEvent(TraceOp o = TraceOp::end, std::int32_t r = -1, std::uint32_t res = 0,
+                        std::string_view t = {}, const Student& s = Student());
+};
+
+/**
+ * @class Trace
+ * @brief A trace loaded from a file.
+ *
+ * A trace file starts with a 32 byte header: the magic `STMSTRC1`, the wall-clock start time
+ * in nanoseconds since the Unix epoch and the TraceState of the store when recording began.
+ * Every event follows as a 32 byte fixed part (op, 3 bytes padding, roll, result, payload
+ * length, time, latency) and its payload: the text argument, or for add the packed form of
+ * the student (StudentSchema::pack) followed by its string heap. The closing `end` event
+ * carries the final TraceState as its payload. Integers are in host byte order.
+ */
+class Trace {
+public:
+    /**
+     * @brief Size in bytes of the file header.
+     */
+    static constexpr std::size_t headerSize = 32;
+
+    /**
+     * @brief Size in bytes of the fixed part of each event.
+     */
+    static constexpr std::size_t eventSize = 32;
+
+    std::uint64_t started; /**< Wall-clock start time, in nanoseconds since the Unix epoch. */
+    TraceState initial; /**< State of the store when recording began. */
+    TraceState final; /**< State of the store when recording ended; valid if `complete`. */
+    bool complete; /**< Whether the trace was closed with an `end` event. */
+    std::vector<TraceEvent> events; /**< The operations, in the order they ran. */
+
+    /**
+     * @brief Default constructor creates an empty, incomplete trace.
+     */
+    Trace();
+
+    /**
+     * @brief Reads a trace file.
+     * @param filename The file to read.
+     * @return true if the file could be opened and has a valid header, false otherwise.
+     *
+     * A trace cut short, e.g. because the program was killed while recording, loads up to
+     * its last whole event and is marked incomplete.
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * @brief Computes the checksum of one student over all of its fields.
+     * @param student The student.
+     * @return A 64-bit FNV-1a hash of the student's fields.
+     */
+    static std::uint64_t checksum(const Student& student);
+
+    /**
+     * @brief Computes the state of a snapshot.
+     * @param view The snapshot.
+     * @return Its size and the sum of the checksums of its students.
+     */
+    static TraceState state(const StudentStore::Snapshot& view);
+};
+
+/**
+ * @class TraceRecorder
+ * @brief Appends operations to a trace file as they happen.
+ *
+ * Each event is written to the file as soon as it is recorded, so a trace survives the
+ * program being killed up to the last operation that finished. Not thread-safe.
+ */
+class TraceRecorder {
+private:
+    std::ofstream out; /**< The trace file. */
+    std::chrono::steady_clock::time_point origin; /**< The time the trace began. */
+    std::string buffer; /**< Encoding buffer reused for every event. */
+    std::string heap; /**< String heap reused for packing students. */
+
+    void write(const TraceEvent& event, std::string_view payload);
+
+public:
+    /**
+     * @brief Creates the trace file and writes its header.
+     * @param filename The file to create; an existing file is overwritten.
+     * @param view The store as it is when recording begins.
+     */
+    TraceRecorder(const std::string& filename, const StudentStore::Snapshot& view);
+
+    /**
+     * @brief Checks whether the file could be created and written so far.
+     * @return true if every write succeeded.
+     */
+    bool good() const;
+
+    /**
+     * @brief Records an operation that has just finished.
+     * @param event The operation; its `time` and `latency` are filled in from `start`.
+     * @param start When the operation started.
+     */
+    void record(TraceEvent event, std::chrono::steady_clock::time_point start);
+
+    /**
+     * @brief Writes the closing `end` event.
+     * @param view The store as it is when recording ends.
+     */
+    void finish(const StudentStore::Snapshot& view);
+};
+
+#endif // TRACE_H